@@ -0,0 +1,311 @@
+#pragma once
+
+#include "Containers/Name.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+	CONSTEXPR u32 NumShards = 16;
+	CONSTEXPR u32 ShardBits = 4;
+	CONSTEXPR u32 InitialSlotsPerShard = 1024;
+
+	CONSTEXPR u32 MaxNames = 16 * 1024 * 1024;
+#if PLATFORM_64BITS
+	CONSTEXPR SIZE_T MaxStringBytes = 256 * 1024 * 1024;
+#else
+	CONSTEXPR SIZE_T MaxStringBytes = 64 * 1024 * 1024;
+#endif
+
+	CONSTEXPR SIZE_T CommitGranularity = 64 * 1024;
+
+	struct FNameEntry
+	{
+		u64 Hash;
+		i32 Len;
+		TCHAR Data[1];
+	};
+
+	// Address space reservation committed from the front as it fills. Only touched under the entries mutex.
+	struct FCommittedReservation
+	{
+		u8* Base;
+		SIZE_T ReservedSize;
+		SIZE_T CommittedSize;
+
+		bool Reserve(SIZE_T size)
+		{
+			Base = (u8*)FPlatformMemory::ReserveAddressSpace(size);
+			ReservedSize = Base != nullptr ? size : 0;
+			CommittedSize = 0;
+			return Base != nullptr;
+		}
+
+		bool EnsureCommitted(SIZE_T size)
+		{
+			if (size <= CommittedSize)
+			{
+				return true;
+			}
+
+			if (size > ReservedSize)
+			{
+				return false;
+			}
+
+			SIZE_T newCommittedSize = FMalloc::Align(size, CommitGranularity);
+			newCommittedSize = newCommittedSize < ReservedSize ? newCommittedSize : ReservedSize;
+
+			if (!FPlatformMemory::CommitPages(Base + CommittedSize, newCommittedSize - CommittedSize))
+			{
+				return false;
+			}
+
+			CommittedSize = newCommittedSize;
+			return true;
+		}
+	};
+
+	// Open addressed table of packed (hash tag << 32 | name index) values, zero meaning empty. The tag always has
+	// its low bit set so an occupied slot is never zero.
+	struct FSlotArray
+	{
+		u32 Mask;
+		std::atomic<u64> Slots[1];
+
+		static SIZE_T GetAllocationSize(u32 capacity)
+		{
+			return sizeof(FSlotArray) + (capacity - 1) * sizeof(std::atomic<u64>);
+		}
+	};
+
+	struct FShard
+	{
+		std::mutex Mutex;
+		std::atomic<FSlotArray*> Slots;
+		u32 NumUsed;
+	};
+
+	/**
+	 * Readers only load the slot array and the slots with acquire and never lock. Writers hold the shard mutex,
+	 * write the entry completely and then publish it with a release store of its slot. Growing a shard copies the
+	 * slots into a new array; the old one is never freed, as a reader may still be probing it, which costs at
+	 * most as much memory as the live arrays. A reader that misses a name because of a concurrent grow falls back
+	 * to the locked path, which probes the current array.
+	 */
+	class FNameTable
+	{
+	public:
+
+		FNameTable()
+		{
+			[[maybe_unused]] const bool bReserved = m_Entries.Reserve((SIZE_T)MaxNames * sizeof(FNameEntry*)) && m_Strings.Reserve(MaxStringBytes);
+			CHECK(bReserved);
+
+			for (FShard& shard : m_Shards)
+			{
+				shard.Slots.store(AllocateSlots(InitialSlotsPerShard), std::memory_order_relaxed);
+				shard.NumUsed = 0;
+			}
+
+			const FNameLiteral none(TEXT("None"));
+			[[maybe_unused]] const u32 noneIndex = FindOrAdd(FStringView(none.Data, none.Len), none.Hash);
+			CHECK(noneIndex == 0);
+		}
+
+		// The table is never destroyed so names held by other statics stay valid at exit.
+		static FNameTable& Get()
+		{
+			alignas(FNameTable) static u8 storage[sizeof(FNameTable)];
+			static FNameTable* table = new (storage) FNameTable();
+			return *table;
+		}
+
+	public:
+
+		u32 FindOrAdd(FStringView view, u64 hash)
+		{
+			FShard& shard = m_Shards[hash & (NumShards - 1)];
+
+			u32 index;
+			if (Find(shard.Slots.load(std::memory_order_acquire), view, hash, index))
+			{
+				return index;
+			}
+
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+
+			FSlotArray* slots = shard.Slots.load(std::memory_order_relaxed);
+			if (Find(slots, view, hash, index))
+			{
+				return index;
+			}
+
+			if ((shard.NumUsed + 1) * 2 > slots->Mask + 1)
+			{
+				slots = Grow(slots);
+				shard.Slots.store(slots, std::memory_order_release);
+			}
+
+			index = AddEntry(view, hash);
+			CHECK(index != InvalidIndex);
+
+			Insert(slots, PackSlot(hash, index), hash);
+			++shard.NumUsed;
+			return index;
+		}
+
+		FORCEINLINE const FNameEntry* GetEntry(u32 index) const
+		{
+			return ((FNameEntry* const*)m_Entries.Base)[index];
+		}
+
+		FORCEINLINE u32 GetNumEntries() const
+		{
+			return m_NumEntries.load(std::memory_order_acquire);
+		}
+
+	private:
+
+		CONSTEXPR static u32 InvalidIndex = 0xFFFFFFFF;
+
+		FORCEINLINE static u64 PackSlot(u64 hash, u32 index)
+		{
+			return ((hash >> 32) | 1) << 32 | index;
+		}
+
+		FORCEINLINE static u32 GetSlotPosition(u64 hash, u32 mask)
+		{
+			return (u32)(hash >> ShardBits) & mask;
+		}
+
+		bool Find(const FSlotArray* slots, FStringView view, u64 hash, u32& outIndex) const
+		{
+			const u64 tag = PackSlot(hash, 0) >> 32;
+
+			for (u32 position = GetSlotPosition(hash, slots->Mask); ; position = (position + 1) & slots->Mask)
+			{
+				const u64 slot = slots->Slots[position].load(std::memory_order_acquire);
+				if (slot == 0)
+				{
+					return false;
+				}
+
+				if ((slot >> 32) != tag)
+				{
+					continue;
+				}
+
+				const FNameEntry* entry = GetEntry((u32)slot);
+				if (entry->Hash == hash && FStringView(entry->Data, entry->Len).Equals(view))
+				{
+					outIndex = (u32)slot;
+					return true;
+				}
+			}
+		}
+
+		static void Insert(FSlotArray* slots, u64 value, u64 hash)
+		{
+			u32 position = GetSlotPosition(hash, slots->Mask);
+			while (slots->Slots[position].load(std::memory_order_relaxed) != 0)
+			{
+				position = (position + 1) & slots->Mask;
+			}
+
+			slots->Slots[position].store(value, std::memory_order_release);
+		}
+
+		static FSlotArray* AllocateSlots(u32 capacity)
+		{
+			// Fresh pages are zeroed, so every slot starts empty.
+			FSlotArray* slots = (FSlotArray*)FPlatformMemory::AllocatePages(FSlotArray::GetAllocationSize(capacity));
+			CHECK(slots != nullptr);
+
+			slots->Mask = capacity - 1;
+			return slots;
+		}
+
+		FSlotArray* Grow(const FSlotArray* slots) const
+		{
+			FSlotArray* newSlots = AllocateSlots((slots->Mask + 1) * 2);
+
+			for (u32 i = 0; i <= slots->Mask; ++i)
+			{
+				const u64 slot = slots->Slots[i].load(std::memory_order_relaxed);
+				if (slot != 0)
+				{
+					Insert(newSlots, slot, GetEntry((u32)slot)->Hash);
+				}
+			}
+
+			return newSlots;
+		}
+
+		u32 AddEntry(FStringView view, u64 hash)
+		{
+			std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+			const u32 index = m_NumEntries.load(std::memory_order_relaxed);
+			const SIZE_T entrySize = FMalloc::Align(sizeof(FNameEntry) + view.Len() * sizeof(TCHAR), alignof(FNameEntry));
+
+			if (index >= MaxNames
+				|| !m_Entries.EnsureCommitted(((SIZE_T)index + 1) * sizeof(FNameEntry*))
+				|| !m_Strings.EnsureCommitted(m_StringsSize + entrySize))
+			{
+				return InvalidIndex;
+			}
+
+			FNameEntry* entry = (FNameEntry*)(m_Strings.Base + m_StringsSize);
+			entry->Hash = hash;
+			entry->Len = view.Len();
+			memcpy(entry->Data, view.GetData(), view.Len() * sizeof(TCHAR));
+			entry->Data[view.Len()] = 0;
+
+			m_StringsSize += entrySize;
+			((FNameEntry**)m_Entries.Base)[index] = entry;
+			m_NumEntries.store(index + 1, std::memory_order_release);
+			return index;
+		}
+
+	private:
+
+		FShard m_Shards[NumShards];
+
+		std::mutex m_EntriesMutex;
+		FCommittedReservation m_Entries;
+		FCommittedReservation m_Strings;
+		SIZE_T m_StringsSize = 0;
+		std::atomic<u32> m_NumEntries{ 0 };
+	};
+}
+
+FName::FName(FStringView view)
+	: m_Index(FNameTable::Get().FindOrAdd(view, FNameLiteral::HashString(view.GetData(), view.Len())))
+{
+}
+
+FName::FName(const FNameLiteral& literal)
+	: m_Index(FNameTable::Get().FindOrAdd(FStringView(literal.Data, literal.Len), literal.Hash))
+{
+}
+
+FStringView FName::ToView() const
+{
+	const FNameEntry* entry = FNameTable::Get().GetEntry(m_Index);
+	return FStringView(entry->Data, entry->Len);
+}
+
+FName FName::FromIndex(u32 index)
+{
+	FName name;
+	name.m_Index = index < FNameTable::Get().GetNumEntries() ? index : 0;
+	return name;
+}
+
+u32 FName::GetNumNames()
+{
+	return FNameTable::Get().GetNumEntries();
+}
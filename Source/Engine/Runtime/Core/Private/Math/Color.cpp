@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Math/Color.h"
+#include "Math/VectorRegister.h"
+
+const float FColor32::SRGBToLinearTable[256] =
+{
+	0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f, 0.00121410796f, 0.00151763496f, 0.00182116195f, 0.00212468882f,
+	0.00242821593f, 0.0027317428f, 0.00303526991f, 0.00334653584f, 0.00367650739f, 0.00402471703f, 0.00439144205f, 0.00477695325f,
+	0.00518151652f, 0.00560539169f, 0.00604883302f, 0.00651209056f, 0.00699541019f, 0.00749903219f, 0.00802319311f, 0.00856812578f,
+	0.00913405884f, 0.00972121768f, 0.010329823f, 0.0109600937f, 0.0116122449f, 0.012286488f, 0.0129830325f, 0.0137020834f,
+	0.0144438436f, 0.0152085144f, 0.0159962941f, 0.0168073755f, 0.0176419541f, 0.01850022f, 0.0193823613f, 0.0202885624f,
+	0.0212190095f, 0.0221738853f, 0.0231533665f, 0.0241576321f, 0.0251868591f, 0.0262412224f, 0.0273208916f, 0.02842604f,
+	0.0295568351f, 0.0307134446f, 0.0318960324f, 0.0331047662f, 0.0343398079f, 0.0356013142f, 0.0368894488f, 0.0382043719f,
+	0.0395462364f, 0.0409151986f, 0.0423114114f, 0.043735031f, 0.045186203f, 0.0466650873f, 0.0481718257f, 0.0497065671f,
+	0.0512694567f, 0.0528606474f, 0.054480277f, 0.0561284907f, 0.0578054301f, 0.0595112368f, 0.0612460524f, 0.0630100146f,
+	0.064803265f, 0.0666259378f, 0.0684781671f, 0.0703600943f, 0.0722718537f, 0.0742135718f, 0.0761853829f, 0.078187421f,
+	0.0802198201f, 0.0822827071f, 0.0843762085f, 0.0865004584f, 0.0886555836f, 0.0908417106f, 0.0930589661f, 0.0953074694f,
+	0.097587347f, 0.0998987257f, 0.102241732f, 0.104616486f, 0.107023105f, 0.10946171f, 0.111932427f, 0.114435375f,
+	0.116970666f, 0.119538426f, 0.122138776f, 0.124771819f, 0.127437681f, 0.130136475f, 0.13286832f, 0.135633335f,
+	0.138431609f, 0.141263291f, 0.144128472f, 0.147027269f, 0.149959788f, 0.152926147f, 0.155926466f, 0.158960834f,
+	0.162029371f, 0.165132195f, 0.168269396f, 0.171441108f, 0.174647406f, 0.177888423f, 0.18116425f, 0.18447499f,
+	0.187820777f, 0.191201687f, 0.194617838f, 0.198069319f, 0.20155625f, 0.205078736f, 0.208636865f, 0.212230757f,
+	0.215860501f, 0.219526201f, 0.223227963f, 0.226965874f, 0.230740055f, 0.23455058f, 0.238397568f, 0.242281124f,
+	0.246201321f, 0.25015828f, 0.254152089f, 0.258182853f, 0.262250662f, 0.266355604f, 0.270497799f, 0.274677306f,
+	0.278894275f, 0.283148736f, 0.287440836f, 0.291770637f, 0.296138257f, 0.300543785f, 0.304987311f, 0.309468925f,
+	0.313988715f, 0.318546772f, 0.323143214f, 0.327778101f, 0.332451522f, 0.337163627f, 0.341914415f, 0.346704066f,
+	0.351532608f, 0.356400132f, 0.361306787f, 0.366252601f, 0.371237695f, 0.376262128f, 0.38132602f, 0.386429429f,
+	0.391572475f, 0.396755219f, 0.401977777f, 0.407240212f, 0.412542611f, 0.417885065f, 0.423267663f, 0.428690493f,
+	0.434153646f, 0.439657182f, 0.445201188f, 0.450785786f, 0.456411034f, 0.462076992f, 0.467783809f, 0.473531485f,
+	0.479320168f, 0.48514995f, 0.491020858f, 0.496932983f, 0.502886474f, 0.50888133f, 0.514917672f, 0.520995557f,
+	0.527115107f, 0.533276379f, 0.539479494f, 0.545724452f, 0.55201143f, 0.558340371f, 0.564711511f, 0.571124852f,
+	0.577580452f, 0.584078431f, 0.590618849f, 0.597201765f, 0.603827357f, 0.610495567f, 0.617206573f, 0.623960376f,
+	0.630757153f, 0.637596846f, 0.644479692f, 0.651405632f, 0.658374846f, 0.665387273f, 0.672443151f, 0.679542482f,
+	0.686685324f, 0.693871737f, 0.701101899f, 0.708375752f, 0.715693474f, 0.723055124f, 0.730460763f, 0.73791039f,
+	0.745404184f, 0.752942204f, 0.760524511f, 0.768151164f, 0.775822222f, 0.783537805f, 0.791297913f, 0.799102724f,
+	0.806952238f, 0.814846575f, 0.822785735f, 0.830769897f, 0.838799f, 0.846873224f, 0.854992628f, 0.863157213f,
+	0.871367097f, 0.8796224f, 0.887923121f, 0.896269381f, 0.904661179f, 0.913098633f, 0.921581864f, 0.930110872f,
+	0.938685715f, 0.947306514f, 0.955973327f, 0.964686275f, 0.973445296f, 0.982250571f, 0.991102099f, 1.0f
+};
+
+namespace
+{
+	// Pixels per block, each register holding one channel of the four. Only the loops encoding to sRGB work on
+	// blocks, the others already fill a register with one pixel and transposing them is slower.
+	constexpr i32 BlockSize = 4;
+
+	FORCEINLINE VectorRegister DecodeColor(const FColor32& color)
+	{
+		const float* table = FColor32::SRGBToLinearTable;
+		return VectorMultiply(VectorSet(table[color.R], table[color.G], table[color.B], (float)color.A), VectorSet(1.0f, 1.0f, 1.0f, 1.0f / 255.0f));
+	}
+
+	FORCEINLINE VectorRegister Premultiply(VectorRegister color)
+	{
+		return Private::VectorWithW(VectorMultiply(color, VectorReplicate<3>(color)), color);
+	}
+
+	/** Transposes four linear colors into one register per channel. */
+	FORCEINLINE void LoadBlock(const FVector4* colors, VectorRegister (&channels)[4])
+	{
+		for (i32 pixel = 0; pixel < BlockSize; ++pixel)
+		{
+			channels[pixel] = VectorLoad(colors[pixel].Components);
+		}
+		VectorTranspose4x4(channels[0], channels[1], channels[2], channels[3]);
+	}
+
+	/** Decodes four colors into one linear register per channel, as FColor32::ToLinear. */
+	FORCEINLINE void DecodeBlock(const FColor32* colors, VectorRegister (&channels)[4])
+	{
+		const float* table = FColor32::SRGBToLinearTable;
+		channels[0] = VectorSet(table[colors[0].R], table[colors[1].R], table[colors[2].R], table[colors[3].R]);
+		channels[1] = VectorSet(table[colors[0].G], table[colors[1].G], table[colors[2].G], table[colors[3].G]);
+		channels[2] = VectorSet(table[colors[0].B], table[colors[1].B], table[colors[2].B], table[colors[3].B]);
+		channels[3] = VectorMultiply(VectorSet((float)colors[0].A, (float)colors[1].A, (float)colors[2].A, (float)colors[3].A), VectorSetFloat1(1.0f / 255.0f));
+	}
+
+	/** Encodes one linear register per channel into four colors, as FColor32::FromLinear. */
+	FORCEINLINE void EncodeBlock(const VectorRegister (&channels)[4], FColor32* colors)
+	{
+		VectorRegister encoded[4] =
+		{
+			Private::VectorEncodeSRGB(channels[0]),
+			Private::VectorEncodeSRGB(channels[1]),
+			Private::VectorEncodeSRGB(channels[2]),
+			Private::VectorEncodeAlpha(channels[3])
+		};
+
+		VectorTranspose4x4(encoded[0], encoded[1], encoded[2], encoded[3]);
+		for (i32 pixel = 0; pixel < BlockSize; ++pixel)
+		{
+			VectorStoreByte4(encoded[pixel], colors[pixel].Components);
+		}
+	}
+
+	/**
+	 * Runs kernel(source, dest) over blocks of four, the last partial block going through copies padded with
+	 * default constructed items. Dest is copied in as well, for the kernels that read it. The kernel has a
+	 * single call site so it is inlined into the loop.
+	 */
+	template<typename SourceType, typename DestType, typename KernelType>
+	void ProcessArray(const SourceType* source, DestType* dest, i32 count, KernelType&& kernel)
+	{
+		SourceType tailSource[BlockSize];
+		DestType tailDest[BlockSize];
+
+		for (i32 i = 0; i < count; i += BlockSize)
+		{
+			const i32 num = count - i < BlockSize ? count - i : BlockSize;
+			const SourceType* blockSource = source + i;
+			DestType* blockDest = dest + i;
+
+			if (num < BlockSize)
+			{
+				for (i32 j = 0; j < num; ++j)
+				{
+					tailSource[j] = source[i + j];
+					tailDest[j] = dest[i + j];
+				}
+
+				blockSource = tailSource;
+				blockDest = tailDest;
+			}
+
+			kernel(blockSource, blockDest);
+
+			if (blockDest == tailDest)
+			{
+				for (i32 j = 0; j < num; ++j)
+				{
+					dest[i + j] = tailDest[j];
+				}
+			}
+		}
+	}
+}
+
+void FColor32::ToLinearArray(const FColor32* source, FVector4* dest, i32 count)
+{
+	for (i32 i = 0; i < count; ++i)
+	{
+		VectorStore(DecodeColor(source[i]), dest[i].Components);
+	}
+}
+
+void FColor32::FromLinearArray(const FVector4* source, FColor32* dest, i32 count)
+{
+	ProcessArray(source, dest, count, [](const FVector4* linear, FColor32* colors)
+	{
+		VectorRegister channels[4];
+		LoadBlock(linear, channels);
+		EncodeBlock(channels, colors);
+	});
+}
+
+void FColor32::PremultiplyAlphaArray(FVector4* colors, i32 count)
+{
+	for (i32 i = 0; i < count; ++i)
+	{
+		VectorStore(Premultiply(VectorLoad(colors[i].Components)), colors[i].Components);
+	}
+}
+
+void FColor32::BlendArray(const FVector4* source, FVector4* dest, i32 count)
+{
+	for (i32 i = 0; i < count; ++i)
+	{
+		const VectorRegister s = VectorLoad(source[i].Components);
+		const VectorRegister d = VectorLoad(dest[i].Components);
+		VectorStore(VectorMultiplyAdd(d, VectorSubtract(VectorOne(), VectorReplicate<3>(s)), s), dest[i].Components);
+	}
+}
+
+void FColor32::BlendArray(const FColor32* source, FColor32* dest, i32 count)
+{
+	ProcessArray(source, dest, count, [](const FColor32* sourceBlock, FColor32* destBlock)
+	{
+		VectorRegister s[4];
+		VectorRegister d[4];
+		DecodeBlock(sourceBlock, s);
+		DecodeBlock(destBlock, d);
+
+		// Blended premultiplied, then divided back by the resulting alpha; fully transparent results are zero.
+		const VectorRegister destWeight = VectorMultiply(d[3], VectorSubtract(VectorOne(), s[3]));
+		const VectorRegister alpha = VectorAdd(s[3], destWeight);
+		const VectorRegister bVisible = VectorCompareGT(alpha, VectorZero());
+
+		VectorRegister blended[4];
+		for (i32 channel = 0; channel < 3; ++channel)
+		{
+			const VectorRegister premultiplied = VectorMultiplyAdd(d[channel], destWeight, VectorMultiply(s[channel], s[3]));
+			blended[channel] = VectorSelect(bVisible, VectorDivide(premultiplied, alpha), VectorZero());
+		}
+		blended[3] = alpha;
+
+		EncodeBlock(blended, destBlock);
+	});
+}
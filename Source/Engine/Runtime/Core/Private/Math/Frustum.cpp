@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Math/Frustum.h"
+#include "HAL/PlatformMisc.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+	#include <immintrin.h>
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+	#else
+		#define TARGET_AVX2_FMA
+	#endif
+#endif
+
+namespace
+{
+	// Bounds as component streams. Spheres keep their radius in ExtentX and leave ExtentY and ExtentZ null.
+	struct FBoundsStreams
+	{
+		const float* X;
+		const float* Y;
+		const float* Z;
+		const float* ExtentX;
+		const float* ExtentY;
+		const float* ExtentZ;
+	};
+
+	/** Culls bounds [begin, end), writing the visible indices from outVisibleIndices on. Returns their number. */
+	template<bool IsBox>
+	i32 CullScalar(const FFrustum& frustum, FBoundsStreams bounds, i32 begin, i32 end, i32* outVisibleIndices)
+	{
+		i32 numVisible = 0;
+		for (i32 i = begin; i < end; ++i)
+		{
+			bool bVisible = true;
+			for (i32 plane = 0; plane < FFrustum::NumPlanes; ++plane)
+			{
+				const FPlane& p = frustum.Planes[plane];
+				const float distance = p.X * bounds.X[i] + p.Y * bounds.Y[i] + p.Z * bounds.Z[i] + p.W;
+				const float radius = IsBox
+					? FMath::Abs(p.X) * bounds.ExtentX[i] + FMath::Abs(p.Y) * bounds.ExtentY[i] + FMath::Abs(p.Z) * bounds.ExtentZ[i]
+					: bounds.ExtentX[i];
+				bVisible &= distance >= -radius;
+			}
+
+			// Written unconditionally and kept only when visible, which leaves no branch to mispredict.
+			outVisibleIndices[numVisible] = i;
+			numVisible += bVisible ? 1 : 0;
+		}
+		return numVisible;
+	}
+
+#if PLATFORM_CPU_X86_FAMILY
+
+	/*--------------------------------------------------------------------------*/
+
+	// For each 8 bit visibility mask, the lanes set in it packed into nibbles from the lowest, and their count.
+	struct FCompactTable
+	{
+		u32 Lanes[256];
+		u8 Counts[256];
+
+		constexpr FCompactTable() : Lanes(), Counts()
+		{
+			for (u32 mask = 0; mask < 256; ++mask)
+			{
+				u32 numLanes = 0;
+				for (u32 lane = 0; lane < 8; ++lane)
+				{
+					if (mask & (1u << lane))
+					{
+						Lanes[mask] |= lane << (numLanes * 4);
+						++numLanes;
+					}
+				}
+				Counts[mask] = (u8)numLanes;
+			}
+		}
+	};
+
+	constexpr FCompactTable CompactTable;
+
+	template<bool IsBox>
+	TARGET_AVX2_FMA i32 CullAVX2(const FFrustum& frustum, FBoundsStreams bounds, i32 count, i32* outVisibleIndices)
+	{
+		__m256 planes[FFrustum::NumPlanes][4];
+		__m256 absNormals[FFrustum::NumPlanes][3];
+		for (i32 plane = 0; plane < FFrustum::NumPlanes; ++plane)
+		{
+			for (i32 component = 0; component < 4; ++component)
+			{
+				planes[plane][component] = _mm256_set1_ps(frustum.Planes[plane].Components[component]);
+			}
+			for (i32 component = 0; component < 3; ++component)
+			{
+				absNormals[plane][component] = _mm256_set1_ps(FMath::Abs(frustum.Planes[plane].Components[component]));
+			}
+		}
+
+		const __m256 signBit = _mm256_set1_ps(-0.0f);
+		const __m256i nibbleShifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+		const __m256i nibbleMask = _mm256_set1_epi32(0xF);
+
+		i32 numVisible = 0;
+		i32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 x = _mm256_loadu_ps(bounds.X + i);
+			const __m256 y = _mm256_loadu_ps(bounds.Y + i);
+			const __m256 z = _mm256_loadu_ps(bounds.Z + i);
+
+			__m256 extentX, extentY, extentZ, negativeRadius;
+			if constexpr (IsBox)
+			{
+				extentX = _mm256_loadu_ps(bounds.ExtentX + i);
+				extentY = _mm256_loadu_ps(bounds.ExtentY + i);
+				extentZ = _mm256_loadu_ps(bounds.ExtentZ + i);
+			}
+			else
+			{
+				negativeRadius = _mm256_xor_ps(_mm256_loadu_ps(bounds.ExtentX + i), signBit);
+			}
+
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (i32 plane = 0; plane < FFrustum::NumPlanes; ++plane)
+			{
+				__m256 distance = _mm256_fmadd_ps(planes[plane][0], x, planes[plane][3]);
+				distance = _mm256_fmadd_ps(planes[plane][1], y, distance);
+				distance = _mm256_fmadd_ps(planes[plane][2], z, distance);
+
+				if constexpr (IsBox)
+				{
+					__m256 radius = _mm256_mul_ps(absNormals[plane][0], extentX);
+					radius = _mm256_fmadd_ps(absNormals[plane][1], extentY, radius);
+					radius = _mm256_fmadd_ps(absNormals[plane][2], extentZ, radius);
+					negativeRadius = _mm256_xor_ps(radius, signBit);
+				}
+
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+			}
+
+			// Left packs the visible indices with one unaligned store of all eight lanes, the ones past the
+			// visible count being overwritten later. numVisible <= i keeps the store within count entries.
+			const i32 mask = _mm256_movemask_ps(visible);
+			const __m256i lanes = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((i32)CompactTable.Lanes[mask]), nibbleShifts), nibbleMask);
+			_mm256_storeu_si256((__m256i*)(outVisibleIndices + numVisible), _mm256_add_epi32(lanes, _mm256_set1_epi32(i)));
+			numVisible += CompactTable.Counts[mask];
+		}
+
+		return numVisible + CullScalar<IsBox>(frustum, bounds, i, count, outVisibleIndices + numVisible);
+	}
+
+#endif
+
+	/*--------------------------------------------------------------------------*/
+
+	template<bool IsBox>
+	i32 Cull(const FFrustum& frustum, FBoundsStreams bounds, i32 count, i32* outVisibleIndices)
+	{
+#if PLATFORM_CPU_X86_FAMILY
+		if (FPlatformMisc::HasCPUFeature(ECPUFeature::AVX2) && FPlatformMisc::HasCPUFeature(ECPUFeature::FMA3))
+		{
+			return CullAVX2<IsBox>(frustum, bounds, count, outVisibleIndices);
+		}
+#endif
+
+		return CullScalar<IsBox>(frustum, bounds, 0, count, outVisibleIndices);
+	}
+}
+
+i32 FFrustum::CullSpheres(const float* centerX, const float* centerY, const float* centerZ, const float* radii, i32 count, i32* outVisibleIndices) const
+{
+	return Cull<false>(*this, { centerX, centerY, centerZ, radii, nullptr, nullptr }, count, outVisibleIndices);
+}
+
+i32 FFrustum::CullBoxes(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, i32 count, i32* outVisibleIndices) const
+{
+	return Cull<true>(*this, { centerX, centerY, centerZ, extentX, extentY, extentZ }, count, outVisibleIndices);
+}
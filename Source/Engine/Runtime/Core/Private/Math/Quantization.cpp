@@ -0,0 +1,424 @@
+#pragma once
+
+#include "Math/Quantization.h"
+#include "Math/VectorRegister.h"
+#include "HAL/PlatformMisc.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+	#include <immintrin.h>
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define TARGET_F16C __attribute__((target("avx,f16c")))
+	#else
+		#define TARGET_F16C
+	#endif
+#endif
+
+static_assert(sizeof(FVector) == 3 * sizeof(float), "Vector arrays are converted as float streams.");
+static_assert(sizeof(FHalfVector) == 3 * sizeof(FFloat16), "Vector arrays are converted as half streams.");
+
+namespace
+{
+	// Items per block, each register holding one component of the four.
+	constexpr i32 BlockSize = 4;
+
+	void EncodeHalfScalar(const float* source, FFloat16* dest, i32 count)
+	{
+		for (i32 i = 0; i < count; ++i)
+		{
+			dest[i].Encoded = Private::FloatToHalf(source[i]);
+		}
+	}
+
+	void DecodeHalfScalar(const FFloat16* source, float* dest, i32 count)
+	{
+		for (i32 i = 0; i < count; ++i)
+		{
+			dest[i] = Private::HalfToFloat(source[i].Encoded);
+		}
+	}
+
+#if PLATFORM_CPU_X86_FAMILY
+
+	TARGET_F16C void EncodeHalfF16C(const float* source, FFloat16* dest, i32 count)
+	{
+		i32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm_storeu_si128((__m128i*)(dest + i), _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+		}
+		EncodeHalfScalar(source + i, dest + i, count - i);
+	}
+
+	TARGET_F16C void DecodeHalfF16C(const FFloat16* source, float* dest, i32 count)
+	{
+		i32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_ps(dest + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(source + i))));
+		}
+		DecodeHalfScalar(source + i, dest + i, count - i);
+	}
+
+#endif
+
+	/*--------------------------------------------------------------------------*/
+
+	/** Transposes four quaternions into one register per component. */
+	FORCEINLINE void LoadQuatBlock(const FQuat* q, VectorRegister (&components)[4])
+	{
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			components[i] = VectorLoad(q[i].Components);
+		}
+		VectorTranspose4x4(components[0], components[1], components[2], components[3]);
+	}
+
+	FORCEINLINE void StoreQuatBlock(VectorRegister (&components)[4], FQuat* q)
+	{
+		VectorTranspose4x4(components[0], components[1], components[2], components[3]);
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			VectorStore(components[i], q[i].Components);
+		}
+	}
+
+	/** Loads four vectors, (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) in memory, as (x0 x1 x2 x3) (y0 ...) (z0 ...). */
+	FORCEINLINE void LoadVectorBlock(const FVector* v, VectorRegister& outX, VectorRegister& outY, VectorRegister& outZ)
+	{
+		const VectorRegister r0 = VectorLoad(v[0].Components);
+		const VectorRegister r1 = VectorLoad(v[0].Components + 4);
+		const VectorRegister r2 = VectorLoad(v[0].Components + 8);
+
+		outX = VectorShuffle<0, 3, 0, 2>(r0, VectorShuffle<2, 2, 1, 1>(r1, r2));
+		outY = VectorShuffle<0, 2, 0, 2>(VectorShuffle<1, 1, 0, 0>(r0, r1), VectorShuffle<3, 3, 2, 2>(r1, r2));
+		outZ = VectorShuffle<0, 2, 0, 3>(VectorShuffle<2, 2, 1, 1>(r0, r1), r2);
+	}
+
+	FORCEINLINE void StoreVectorBlock(VectorRegister x, VectorRegister y, VectorRegister z, FVector* v)
+	{
+		VectorStore(VectorShuffle<0, 2, 0, 2>(VectorShuffle<0, 0, 0, 0>(x, y), VectorShuffle<0, 0, 1, 1>(z, x)), v[0].Components);
+		VectorStore(VectorShuffle<0, 2, 0, 2>(VectorShuffle<1, 1, 1, 1>(y, z), VectorShuffle<2, 2, 2, 2>(x, y)), v[0].Components + 4);
+		VectorStore(VectorShuffle<0, 2, 0, 2>(VectorShuffle<2, 2, 3, 3>(z, x), VectorShuffle<3, 3, 3, 3>(y, z)), v[0].Components + 8);
+	}
+
+	/**
+	 * Converts blocks of four with kernel(source, dest), the last partial block going through padded copies.
+	 * SourcePadding fills the copy past the end of the source.
+	 */
+	template<typename SourceType, typename DestType, typename KernelType>
+	void ConvertArray(const SourceType* source, DestType* dest, i32 count, const SourceType& sourcePadding, KernelType&& kernel)
+	{
+		const i32 numBlocked = count - count % BlockSize;
+		for (i32 i = 0; i < numBlocked; i += BlockSize)
+		{
+			kernel(source + i, dest + i);
+		}
+
+		if (numBlocked == count)
+		{
+			return;
+		}
+
+		SourceType tailSource[BlockSize] = { sourcePadding, sourcePadding, sourcePadding, sourcePadding };
+		DestType tailDest[BlockSize];
+
+		for (i32 i = numBlocked; i < count; ++i)
+		{
+			tailSource[i - numBlocked] = source[i];
+		}
+
+		kernel(tailSource, tailDest);
+
+		for (i32 i = numBlocked; i < count; ++i)
+		{
+			dest[i] = tailDest[i - numBlocked];
+		}
+	}
+
+	/*--------------------------------------------------------------------------*/
+
+	template<typename QuantizedType>
+	FORCEINLINE void EncodeQuatBlock(const FQuat* source, QuantizedType* dest)
+	{
+		using FSmallestThree = Private::TSmallestThree<QuantizedType::ComponentBits>;
+
+		VectorRegister c[4];
+		LoadQuatBlock(source, c);
+
+		// The first largest component wins ties, like in the scalar encoding.
+		const VectorRegister abs[4] = { VectorAbs(c[0]), VectorAbs(c[1]), VectorAbs(c[2]), VectorAbs(c[3]) };
+		const VectorRegister maxAbs = VectorMax(VectorMax(abs[0], abs[1]), VectorMax(abs[2], abs[3]));
+		const VectorRegister bLargest0 = VectorCompareEQ(abs[0], maxAbs);
+		const VectorRegister bLargestUpTo1 = VectorBitwiseOr(bLargest0, VectorCompareEQ(abs[1], maxAbs));
+		const VectorRegister bLargestUpTo2 = VectorBitwiseOr(bLargestUpTo1, VectorCompareEQ(abs[2], maxAbs));
+
+		const VectorRegister one = VectorOne();
+		const VectorRegister largest = VectorSubtract(VectorSetFloat1(3.0f), VectorAdd(VectorAdd(VectorBitwiseAnd(bLargest0, one), VectorBitwiseAnd(bLargestUpTo1, one)), VectorBitwiseAnd(bLargestUpTo2, one)));
+
+		// The components left of the largest stay in place, the ones right of it move down one.
+		const VectorRegister largestValue = VectorSelect(bLargest0, c[0], VectorSelect(bLargestUpTo1, c[1], VectorSelect(bLargestUpTo2, c[2], c[3])));
+		const VectorRegister sign = VectorBitwiseAnd(largestValue, VectorSetFloat1(-0.0f));
+		const VectorRegister smallest[3] =
+		{
+			VectorSelect(bLargest0, c[1], c[0]),
+			VectorSelect(bLargestUpTo1, c[2], c[1]),
+			VectorSelect(bLargestUpTo2, c[3], c[2])
+		};
+
+		const VectorRegister scale = VectorSetFloat1(FSmallestThree::Scale);
+		const VectorRegister offset = VectorSetFloat1(FSmallestThree::MaxValue * 0.5f);
+		const VectorRegister maxValue = VectorSetFloat1((float)FSmallestThree::MaxValue);
+
+		float quantized[3][BlockSize];
+		for (i32 component = 0; component < 3; ++component)
+		{
+			const VectorRegister value = VectorMultiplyAdd(VectorBitwiseXor(smallest[component], sign), scale, offset);
+			VectorStore(VectorRound(VectorMin(VectorMax(value, VectorZero()), maxValue)), quantized[component]);
+		}
+
+		float largestIndices[BlockSize];
+		VectorStore(largest, largestIndices);
+
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			const u32 components[3] = { (u32)quantized[0][i], (u32)quantized[1][i], (u32)quantized[2][i] };
+			dest[i].Pack((u32)largestIndices[i], components);
+		}
+	}
+
+	template<typename QuantizedType>
+	FORCEINLINE void DecodeQuatBlock(const QuantizedType* source, FQuat* dest)
+	{
+		using FSmallestThree = Private::TSmallestThree<QuantizedType::ComponentBits>;
+
+		float largestIndices[BlockSize];
+		float quantized[3][BlockSize];
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			u32 largest, components[3];
+			source[i].Unpack(largest, components);
+
+			largestIndices[i] = (float)largest;
+			quantized[0][i] = (float)components[0];
+			quantized[1][i] = (float)components[1];
+			quantized[2][i] = (float)components[2];
+		}
+
+		const VectorRegister invScale = VectorSetFloat1(FSmallestThree::InvScale);
+		const VectorRegister range = VectorSetFloat1(FSmallestThree::Range);
+
+		VectorRegister smallest[3];
+		VectorRegister squaredSum = VectorZero();
+		for (i32 component = 0; component < 3; ++component)
+		{
+			smallest[component] = VectorSubtract(VectorMultiply(VectorLoad(quantized[component]), invScale), range);
+			squaredSum = VectorMultiplyAdd(smallest[component], smallest[component], squaredSum);
+		}
+
+		const VectorRegister largestValue = VectorSqrt(VectorMax(VectorSubtract(VectorOne(), squaredSum), VectorZero()));
+		const VectorRegister largest = VectorLoad(largestIndices);
+
+		// Component i is the largest one, or the smallest one at i - 1 right of it, or at i left of it.
+		VectorRegister c[4];
+		for (i32 component = 0; component < 4; ++component)
+		{
+			const VectorRegister index = VectorSetFloat1((float)component);
+			const VectorRegister left = component < 3 ? smallest[component] : smallest[2];
+			const VectorRegister right = component > 0 ? smallest[component - 1] : smallest[0];
+			c[component] = VectorSelect(VectorCompareEQ(largest, index), largestValue, VectorSelect(VectorCompareLT(largest, index), right, left));
+		}
+
+		StoreQuatBlock(c, dest);
+	}
+
+	/*--------------------------------------------------------------------------*/
+
+	FORCEINLINE void EncodeNormalBlock(const FVector* source, FOctahedralNormal* dest)
+	{
+		VectorRegister x, y, z;
+		LoadVectorBlock(source, x, y, z);
+
+		const VectorRegister signBit = VectorSetFloat1(-0.0f);
+		const VectorRegister invLength = VectorDivide(VectorOne(), VectorAdd(VectorAdd(VectorAbs(x), VectorAbs(y)), VectorAbs(z)));
+		x = VectorMultiply(x, invLength);
+		y = VectorMultiply(y, invLength);
+
+		// Folds the lower half, (1 - |y|, 1 - |x|) with the signs of (x, y).
+		const VectorRegister bLowerHalf = VectorCompareLT(z, VectorZero());
+		const VectorRegister foldedX = VectorBitwiseOr(VectorSubtract(VectorOne(), VectorAbs(y)), VectorBitwiseAnd(x, signBit));
+		const VectorRegister foldedY = VectorBitwiseOr(VectorSubtract(VectorOne(), VectorAbs(x)), VectorBitwiseAnd(y, signBit));
+
+		const VectorRegister maxValue = VectorSetFloat1(FOctahedralNormal::MaxValue);
+		float quantizedX[BlockSize];
+		float quantizedY[BlockSize];
+		VectorStore(VectorRound(VectorMultiply(VectorSelect(bLowerHalf, foldedX, x), maxValue)), quantizedX);
+		VectorStore(VectorRound(VectorMultiply(VectorSelect(bLowerHalf, foldedY, y), maxValue)), quantizedY);
+
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			dest[i].X = (i16)quantizedX[i];
+			dest[i].Y = (i16)quantizedY[i];
+		}
+	}
+
+	FORCEINLINE void DecodeNormalBlock(const FOctahedralNormal* source, FVector* dest)
+	{
+		float quantizedX[BlockSize];
+		float quantizedY[BlockSize];
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			quantizedX[i] = (float)source[i].X;
+			quantizedY[i] = (float)source[i].Y;
+		}
+
+		VectorRegister x, y, z;
+		Private::VectorDecodeOctahedral(VectorLoad(quantizedX), VectorLoad(quantizedY), x, y, z);
+		StoreVectorBlock(x, y, z, dest);
+	}
+
+	/*--------------------------------------------------------------------------*/
+
+	// Per component box constants spread like the components of four vectors, (x y z x) (y z x y) (z x y z).
+	struct FBoxConstants
+	{
+		VectorRegister Min[3];
+		VectorRegister Scale[3];
+		VectorRegister Step[3];
+
+		explicit FBoxConstants(const FBox& bounds)
+		{
+			const FVector size = bounds.GetSize();
+			const VectorRegister min = VectorSet(bounds.Min.X, bounds.Min.Y, bounds.Min.Z, 0.0f);
+			const VectorRegister scale = VectorSet
+			(
+				size.X > 0.0f ? FQuantizedVector::MaxValue / size.X : 0.0f,
+				size.Y > 0.0f ? FQuantizedVector::MaxValue / size.Y : 0.0f,
+				size.Z > 0.0f ? FQuantizedVector::MaxValue / size.Z : 0.0f,
+				0.0f
+			);
+			const VectorRegister step = VectorMultiply(VectorSet(size.X, size.Y, size.Z, 0.0f), VectorSetFloat1(1.0f / FQuantizedVector::MaxValue));
+
+			Spread(min, Min);
+			Spread(scale, Scale);
+			Spread(step, Step);
+		}
+
+		FORCEINLINE static void Spread(VectorRegister v, VectorRegister (&outSpread)[3])
+		{
+			outSpread[0] = VectorSwizzle<0, 1, 2, 0>(v);
+			outSpread[1] = VectorSwizzle<1, 2, 0, 1>(v);
+			outSpread[2] = VectorSwizzle<2, 0, 1, 2>(v);
+		}
+	};
+}
+
+void FFloat16::EncodeArray(const float* source, FFloat16* dest, i32 count)
+{
+#if PLATFORM_CPU_X86_FAMILY
+	if (FPlatformMisc::HasCPUFeature(ECPUFeature::F16C))
+	{
+		EncodeHalfF16C(source, dest, count);
+		return;
+	}
+#endif
+
+	EncodeHalfScalar(source, dest, count);
+}
+
+void FFloat16::DecodeArray(const FFloat16* source, float* dest, i32 count)
+{
+#if PLATFORM_CPU_X86_FAMILY
+	if (FPlatformMisc::HasCPUFeature(ECPUFeature::F16C))
+	{
+		DecodeHalfF16C(source, dest, count);
+		return;
+	}
+#endif
+
+	DecodeHalfScalar(source, dest, count);
+}
+
+void FHalfVector::EncodeArray(const FVector* source, FHalfVector* dest, i32 count)
+{
+	FFloat16::EncodeArray(source->Components, &dest->X, count * 3);
+}
+
+void FHalfVector::DecodeArray(const FHalfVector* source, FVector* dest, i32 count)
+{
+	FFloat16::DecodeArray(&source->X, dest->Components, count * 3);
+}
+
+void FQuantizedQuat32::EncodeArray(const FQuat* source, FQuantizedQuat32* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FQuat::Identity, EncodeQuatBlock<FQuantizedQuat32>);
+}
+
+void FQuantizedQuat32::DecodeArray(const FQuantizedQuat32* source, FQuat* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FQuantizedQuat32(), DecodeQuatBlock<FQuantizedQuat32>);
+}
+
+void FQuantizedQuat48::EncodeArray(const FQuat* source, FQuantizedQuat48* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FQuat::Identity, EncodeQuatBlock<FQuantizedQuat48>);
+}
+
+void FQuantizedQuat48::DecodeArray(const FQuantizedQuat48* source, FQuat* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FQuantizedQuat48(), DecodeQuatBlock<FQuantizedQuat48>);
+}
+
+void FOctahedralNormal::EncodeArray(const FVector* source, FOctahedralNormal* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FVector::Forward, EncodeNormalBlock);
+}
+
+void FOctahedralNormal::DecodeArray(const FOctahedralNormal* source, FVector* dest, i32 count)
+{
+	ConvertArray(source, dest, count, FOctahedralNormal(), DecodeNormalBlock);
+}
+
+void FQuantizedVector::EncodeArray(const FVector* source, FQuantizedVector* dest, i32 count, const FBox& bounds)
+{
+	const FBoxConstants constants(bounds);
+	const VectorRegister maxValue = VectorSetFloat1(MaxValue);
+
+	ConvertArray(source, dest, count, bounds.Min, [&](const FVector* blockSource, FQuantizedVector* blockDest)
+	{
+		float quantized[3 * BlockSize];
+		for (i32 part = 0; part < 3; ++part)
+		{
+			const VectorRegister offset = VectorSubtract(VectorLoad(blockSource[0].Components + part * 4), constants.Min[part]);
+			VectorStore(VectorRound(VectorMin(VectorMax(VectorMultiply(offset, constants.Scale[part]), VectorZero()), maxValue)), quantized + part * 4);
+		}
+
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			blockDest[i].X = (u16)quantized[i * 3 + 0];
+			blockDest[i].Y = (u16)quantized[i * 3 + 1];
+			blockDest[i].Z = (u16)quantized[i * 3 + 2];
+		}
+	});
+}
+
+void FQuantizedVector::DecodeArray(const FQuantizedVector* source, FVector* dest, i32 count, const FBox& bounds)
+{
+	const FBoxConstants constants(bounds);
+
+	ConvertArray(source, dest, count, FQuantizedVector(), [&](const FQuantizedVector* blockSource, FVector* blockDest)
+	{
+		float quantized[3 * BlockSize];
+		for (i32 i = 0; i < BlockSize; ++i)
+		{
+			quantized[i * 3 + 0] = (float)blockSource[i].X;
+			quantized[i * 3 + 1] = (float)blockSource[i].Y;
+			quantized[i * 3 + 2] = (float)blockSource[i].Z;
+		}
+
+		for (i32 part = 0; part < 3; ++part)
+		{
+			VectorStore(VectorMultiplyAdd(VectorLoad(quantized + part * 4), constants.Step[part], constants.Min[part]), blockDest[0].Components + part * 4);
+		}
+	});
+}
@@ -1,5 +1,179 @@
-#pragma once 
+#pragma once
 
 #include "Math/Quat.h"
+#include "Math/VectorRegister.h"
+#include "Math/VectorMath.h"
 
-const FQuat FQuat::Identity(0, 0, 0, 1);
\ No newline at end of file
+namespace
+{
+	// Bones per block, each register holds one component of the four.
+	constexpr i32 BlockSize = 4;
+
+	// Cosine of half the angle between rotations two degrees apart. Closer than that, NLerp is within
+	// 2e-7 rad of Slerp, below the precision Slerp itself reaches in floats.
+	constexpr float SlerpNLerpThreshold = 0.99985f;
+
+	/** Flips b onto the hemisphere of a and returns the cosine of the half angle between them, in [0, 1]. */
+	FORCEINLINE VectorRegister AlignHemisphere(const VectorRegister (&a)[4], VectorRegister (&b)[4])
+	{
+		VectorRegister dot = VectorMultiply(a[0], b[0]);
+		dot = VectorMultiplyAdd(a[1], b[1], dot);
+		dot = VectorMultiplyAdd(a[2], b[2], dot);
+		dot = VectorMultiplyAdd(a[3], b[3], dot);
+
+		const VectorRegister sign = VectorBitwiseAnd(dot, VectorSetFloat1(-0.0f));
+		for (i32 component = 0; component < 4; ++component)
+		{
+			b[component] = VectorBitwiseXor(b[component], sign);
+		}
+		return VectorBitwiseXor(dot, sign);
+	}
+
+	/** Returns a * scaleA + b * scaleB, normalized. */
+	FORCEINLINE void CombineNormalized(const VectorRegister (&a)[4], const VectorRegister (&b)[4], VectorRegister scaleA, VectorRegister scaleB, VectorRegister (&result)[4])
+	{
+		VectorRegister squaredLength = VectorZero();
+		for (i32 component = 0; component < 4; ++component)
+		{
+			result[component] = VectorMultiplyAdd(b[component], scaleB, VectorMultiply(a[component], scaleA));
+			squaredLength = VectorMultiplyAdd(result[component], result[component], squaredLength);
+		}
+
+		const VectorRegister invLength = VectorReciprocalSqrt(squaredLength);
+		for (i32 component = 0; component < 4; ++component)
+		{
+			result[component] = VectorMultiply(result[component], invLength);
+		}
+	}
+
+	FORCEINLINE void NLerpBlock(const VectorRegister (&a)[4], VectorRegister (&b)[4], VectorRegister weights, VectorRegister (&result)[4])
+	{
+		AlignHemisphere(a, b);
+		CombineNormalized(a, b, VectorSubtract(VectorOne(), weights), weights, result);
+	}
+
+	FORCEINLINE void SlerpBlock(const VectorRegister (&a)[4], VectorRegister (&b)[4], VectorRegister weights, VectorRegister (&result)[4])
+	{
+		const VectorRegister cosAngle = VectorMin(AlignHemisphere(a, b), VectorOne());
+		const VectorRegister bNLerp = VectorCompareGE(cosAngle, VectorSetFloat1(SlerpNLerpThreshold));
+
+		VectorRegister scaleA = VectorSubtract(VectorOne(), weights);
+		VectorRegister scaleB = weights;
+
+		if (VectorMaskBits(bNLerp) != 0xF)
+		{
+			// sin((1 - t) angle) / sin(angle) and sin(t angle) / sin(angle).
+			const VectorRegister angle = VectorAcos(cosAngle);
+			const VectorRegister invSin = VectorReciprocalSqrt(VectorSubtract(VectorOne(), VectorMultiply(cosAngle, cosAngle)));
+
+			VectorRegister sinA, sinB, unused;
+			VectorSinCos(VectorMultiply(scaleA, angle), sinA, unused);
+			VectorSinCos(VectorMultiply(scaleB, angle), sinB, unused);
+
+			scaleA = VectorSelect(bNLerp, scaleA, VectorMultiply(sinA, invSin));
+			scaleB = VectorSelect(bNLerp, scaleB, VectorMultiply(sinB, invSin));
+		}
+
+		// Slerp keeps the length already, normalizing also covers the NLerp lanes.
+		CombineNormalized(a, b, scaleA, scaleB, result);
+	}
+
+	FORCEINLINE void AdditiveBlock(const VectorRegister (&base)[4], VectorRegister (&additive)[4], VectorRegister weights, VectorRegister (&result)[4])
+	{
+		const VectorRegister identity[4] = { VectorZero(), VectorZero(), VectorZero(), VectorOne() };
+
+		VectorRegister p[4];
+		NLerpBlock(identity, additive, weights, p);
+
+		const VectorRegister (&q)[4] = base;
+		result[0] = VectorSubtract(VectorMultiplyAdd(p[3], q[0], VectorMultiplyAdd(p[0], q[3], VectorMultiply(p[1], q[2]))), VectorMultiply(p[2], q[1]));
+		result[1] = VectorSubtract(VectorMultiplyAdd(p[3], q[1], VectorMultiplyAdd(p[1], q[3], VectorMultiply(p[2], q[0]))), VectorMultiply(p[0], q[2]));
+		result[2] = VectorSubtract(VectorMultiplyAdd(p[3], q[2], VectorMultiplyAdd(p[2], q[3], VectorMultiply(p[0], q[1]))), VectorMultiply(p[1], q[0]));
+		result[3] = VectorSubtract(VectorSubtract(VectorSubtract(VectorMultiply(p[3], q[3]), VectorMultiply(p[0], q[0])), VectorMultiply(p[1], q[1])), VectorMultiply(p[2], q[2]));
+	}
+
+	/** Transposes four quaternions into one register per component. */
+	FORCEINLINE void LoadBlock(const FQuat* q, VectorRegister (&components)[4])
+	{
+		for (i32 bone = 0; bone < BlockSize; ++bone)
+		{
+			components[bone] = VectorLoad(q[bone].Components);
+		}
+		VectorTranspose4x4(components[0], components[1], components[2], components[3]);
+	}
+
+	FORCEINLINE void StoreBlock(VectorRegister (&components)[4], FQuat* q)
+	{
+		VectorTranspose4x4(components[0], components[1], components[2], components[3]);
+		for (i32 bone = 0; bone < BlockSize; ++bone)
+		{
+			VectorStore(components[bone], q[bone].Components);
+		}
+	}
+
+	template<typename KernelType>
+	FORCEINLINE void BlendBlock(const FQuat* a, const FQuat* b, FQuat* dest, VectorRegister weights, KernelType& kernel)
+	{
+		VectorRegister blockA[4];
+		VectorRegister blockB[4];
+		LoadBlock(a, blockA);
+		LoadBlock(b, blockB);
+
+		VectorRegister result[4];
+		kernel(blockA, blockB, weights, result);
+		StoreBlock(result, dest);
+	}
+
+	template<typename KernelType>
+	void BlendArray(const FQuat* a, const FQuat* b, FQuat* dest, i32 count, float alpha, const float* boneWeights, KernelType&& kernel)
+	{
+		const VectorRegister alphas = VectorSetFloat1(alpha);
+		const i32 numBlocked = count - count % BlockSize;
+
+		for (i32 i = 0; i < numBlocked; i += BlockSize)
+		{
+			const VectorRegister weights = boneWeights ? VectorMultiply(VectorLoad(boneWeights + i), alphas) : alphas;
+			BlendBlock(a + i, b + i, dest + i, weights, kernel);
+		}
+
+		if (numBlocked == count)
+		{
+			return;
+		}
+
+		// The last partial block goes through a padded copy, the padding bones being identities.
+		FQuat tailA[BlockSize];
+		FQuat tailB[BlockSize];
+		FQuat tailDest[BlockSize];
+		float tailWeights[BlockSize] = {};
+
+		for (i32 i = numBlocked; i < count; ++i)
+		{
+			tailA[i - numBlocked] = a[i];
+			tailB[i - numBlocked] = b[i];
+			tailWeights[i - numBlocked] = boneWeights ? boneWeights[i] : 1.0f;
+		}
+
+		BlendBlock(tailA, tailB, tailDest, VectorMultiply(VectorLoad(tailWeights), alphas), kernel);
+
+		for (i32 i = numBlocked; i < count; ++i)
+		{
+			dest[i] = tailDest[i - numBlocked];
+		}
+	}
+}
+
+void FQuat::NLerpArray(const FQuat* a, const FQuat* b, FQuat* dest, i32 count, float alpha, const float* boneWeights)
+{
+	BlendArray(a, b, dest, count, alpha, boneWeights, NLerpBlock);
+}
+
+void FQuat::SlerpArray(const FQuat* a, const FQuat* b, FQuat* dest, i32 count, float alpha, const float* boneWeights)
+{
+	BlendArray(a, b, dest, count, alpha, boneWeights, SlerpBlock);
+}
+
+void FQuat::ApplyAdditiveArray(const FQuat* base, const FQuat* additive, FQuat* dest, i32 count, float alpha, const float* boneWeights)
+{
+	BlendArray(base, additive, dest, count, alpha, boneWeights, AdditiveBlock);
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "Math/RectTree.h"
+
+namespace
+{
+	FORCEINLINE VectorRegister BoundsFromRect(const FRect& rect)
+	{
+		return VectorSet(rect.X, rect.Y, -(rect.X + rect.Width), -(rect.Y + rect.Height));
+	}
+
+	FORCEINLINE VectorRegister UnionBounds(VectorRegister a, VectorRegister b)
+	{
+		return VectorMin(a, b);
+	}
+
+	/** Half the perimeter, the cost the insertion heuristic minimizes. */
+	FORCEINLINE float GetPerimeter(VectorRegister bounds)
+	{
+		return -(VectorGetComponent<0>(bounds) + VectorGetComponent<1>(bounds) + VectorGetComponent<2>(bounds) + VectorGetComponent<3>(bounds));
+	}
+
+	FORCEINLINE bool ContainsBounds(VectorRegister outer, VectorRegister inner)
+	{
+		return VectorMaskBits(VectorCompareLE(outer, inner)) == 0xF;
+	}
+}
+
+FRectTree::FRectTree(float margin)
+	: m_Root(NullNode)
+	, m_FreeList(NullNode)
+	, m_NumProxies(0)
+	, m_Margin(margin)
+{
+}
+
+i32 FRectTree::CreateProxy(const FRect& rect, void* userData)
+{
+	const i32 proxyId = AllocateNode();
+	FNode& node = m_Nodes[proxyId];
+
+	VectorStoreAligned(VectorSubtract(BoundsFromRect(rect), VectorSetFloat1(m_Margin)), node.Bounds);
+	node.UserData = userData;
+	node.Height = 0;
+
+	InsertLeaf(proxyId);
+	++m_NumProxies;
+	return proxyId;
+}
+
+void FRectTree::DestroyProxy(i32 proxyId)
+{
+	CHECK(m_Nodes.IsValidIndex(proxyId) && m_Nodes[proxyId].IsLeaf());
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	--m_NumProxies;
+}
+
+bool FRectTree::MoveProxy(i32 proxyId, const FRect& rect, const FVector2& displacement)
+{
+	CHECK(m_Nodes.IsValidIndex(proxyId) && m_Nodes[proxyId].IsLeaf());
+
+	const VectorRegister bounds = BoundsFromRect(rect);
+	if (ContainsBounds(VectorLoadAligned(m_Nodes[proxyId].Bounds), bounds))
+	{
+		return false;
+	}
+
+	// Stretch towards the motion: a positive displacement moves the max side, a negative one the min side.
+	const VectorRegister stretch = VectorSet(displacement.X, displacement.Y, -displacement.X, -displacement.Y);
+	const VectorRegister fatBounds = VectorAdd(VectorSubtract(bounds, VectorSetFloat1(m_Margin)), VectorMin(stretch, VectorZero()));
+
+	RemoveLeaf(proxyId);
+	VectorStoreAligned(fatBounds, m_Nodes[proxyId].Bounds);
+	InsertLeaf(proxyId);
+	return true;
+}
+
+/*--------------------------------------------------------------------------*/
+
+i32 FRectTree::AllocateNode()
+{
+	if (m_FreeList == NullNode)
+	{
+		m_FreeList = m_Nodes.Num();
+		m_Nodes.AddUninitialized(1);
+		m_Nodes.Last().Next = NullNode;
+	}
+
+	const i32 index = m_FreeList;
+	FNode& node = m_Nodes[index];
+	m_FreeList = node.Next;
+
+	node.Parent = NullNode;
+	node.Child1 = NullNode;
+	node.Child2 = NullNode;
+	node.Height = 0;
+	node.UserData = nullptr;
+	return index;
+}
+
+void FRectTree::FreeNode(i32 index)
+{
+	FNode& node = m_Nodes[index];
+	node.Next = m_FreeList;
+	node.Height = -1;
+	m_FreeList = index;
+}
+
+void FRectTree::InsertLeaf(i32 leaf)
+{
+	if (m_Root == NullNode)
+	{
+		m_Root = leaf;
+		m_Nodes[leaf].Parent = NullNode;
+		return;
+	}
+
+	// Descend towards the sibling for which the perimeters added to the tree are the smallest.
+	const VectorRegister leafBounds = VectorLoadAligned(m_Nodes[leaf].Bounds);
+	i32 index = m_Root;
+
+	while (!m_Nodes[index].IsLeaf())
+	{
+		const FNode& node = m_Nodes[index];
+		const VectorRegister bounds = VectorLoadAligned(node.Bounds);
+		const float combinedPerimeter = GetPerimeter(UnionBounds(bounds, leafBounds));
+
+		// Cost of pairing the leaf with this node, and the cost pushed onto the children for descending.
+		const float cost = 2.0f * combinedPerimeter;
+		const float inheritanceCost = 2.0f * (combinedPerimeter - GetPerimeter(bounds));
+
+		float childCosts[2];
+		const i32 children[2] = { node.Child1, node.Child2 };
+		for (i32 child = 0; child < 2; ++child)
+		{
+			const FNode& childNode = m_Nodes[children[child]];
+			const VectorRegister childBounds = VectorLoadAligned(childNode.Bounds);
+			const float pairPerimeter = GetPerimeter(UnionBounds(childBounds, leafBounds));
+			childCosts[child] = (childNode.IsLeaf() ? pairPerimeter : pairPerimeter - GetPerimeter(childBounds)) + inheritanceCost;
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1])
+		{
+			break;
+		}
+
+		index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+	}
+
+	const i32 sibling = index;
+	const i32 oldParent = m_Nodes[sibling].Parent;
+	const i32 newParent = AllocateNode();
+
+	FNode& parentNode = m_Nodes[newParent];
+	parentNode.Parent = oldParent;
+	parentNode.Child1 = sibling;
+	parentNode.Child2 = leaf;
+	parentNode.Height = m_Nodes[sibling].Height + 1;
+	VectorStoreAligned(UnionBounds(leafBounds, VectorLoadAligned(m_Nodes[sibling].Bounds)), parentNode.Bounds);
+
+	if (oldParent != NullNode)
+	{
+		FNode& oldParentNode = m_Nodes[oldParent];
+		(oldParentNode.Child1 == sibling ? oldParentNode.Child1 : oldParentNode.Child2) = newParent;
+	}
+	else
+	{
+		m_Root = newParent;
+	}
+
+	m_Nodes[sibling].Parent = newParent;
+	m_Nodes[leaf].Parent = newParent;
+
+	Refit(m_Nodes[leaf].Parent);
+}
+
+void FRectTree::RemoveLeaf(i32 leaf)
+{
+	if (leaf == m_Root)
+	{
+		m_Root = NullNode;
+		return;
+	}
+
+	const i32 parent = m_Nodes[leaf].Parent;
+	const i32 grandParent = m_Nodes[parent].Parent;
+	const i32 sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+	// The sibling takes the place of the parent.
+	m_Nodes[sibling].Parent = grandParent;
+	FreeNode(parent);
+
+	if (grandParent == NullNode)
+	{
+		m_Root = sibling;
+		return;
+	}
+
+	FNode& grandParentNode = m_Nodes[grandParent];
+	(grandParentNode.Child1 == parent ? grandParentNode.Child1 : grandParentNode.Child2) = sibling;
+
+	Refit(grandParent);
+}
+
+void FRectTree::Refit(i32 index)
+{
+	while (index != NullNode)
+	{
+		index = Balance(index);
+
+		FNode& node = m_Nodes[index];
+		const FNode& child1 = m_Nodes[node.Child1];
+		const FNode& child2 = m_Nodes[node.Child2];
+
+		node.Height = 1 + FMath::Max(child1.Height, child2.Height);
+		VectorStoreAligned(UnionBounds(VectorLoadAligned(child1.Bounds), VectorLoadAligned(child2.Bounds)), node.Bounds);
+
+		index = node.Parent;
+	}
+}
+
+i32 FRectTree::Balance(i32 indexA)
+{
+	FNode& a = m_Nodes[indexA];
+	if (a.IsLeaf() || a.Height < 2)
+	{
+		return indexA;
+	}
+
+	const i32 indexB = a.Child1;
+	const i32 indexC = a.Child2;
+	const i32 balance = m_Nodes[indexC].Height - m_Nodes[indexB].Height;
+
+	if (balance >= -1 && balance <= 1)
+	{
+		return indexA;
+	}
+
+	// The taller child U moves up to A's place and A becomes its first child. A keeps its other child and
+	// takes the shorter child of U; U keeps the taller one.
+	const bool bRotateC = balance > 1;
+	const i32 indexU = bRotateC ? indexC : indexB;
+	FNode& u = m_Nodes[indexU];
+
+	const i32 indexTall = m_Nodes[u.Child1].Height > m_Nodes[u.Child2].Height ? u.Child1 : u.Child2;
+	const i32 indexShort = indexTall == u.Child1 ? u.Child2 : u.Child1;
+
+	u.Parent = a.Parent;
+	a.Parent = indexU;
+	if (u.Parent != NullNode)
+	{
+		FNode& parent = m_Nodes[u.Parent];
+		(parent.Child1 == indexA ? parent.Child1 : parent.Child2) = indexU;
+	}
+	else
+	{
+		m_Root = indexU;
+	}
+
+	u.Child1 = indexA;
+	u.Child2 = indexTall;
+	(bRotateC ? a.Child2 : a.Child1) = indexShort;
+	m_Nodes[indexShort].Parent = indexA;
+
+	const FNode& kept = m_Nodes[bRotateC ? indexB : indexC];
+	const FNode& shortNode = m_Nodes[indexShort];
+	const FNode& tallNode = m_Nodes[indexTall];
+
+	const VectorRegister boundsA = UnionBounds(VectorLoadAligned(kept.Bounds), VectorLoadAligned(shortNode.Bounds));
+	VectorStoreAligned(boundsA, a.Bounds);
+	VectorStoreAligned(UnionBounds(boundsA, VectorLoadAligned(tallNode.Bounds)), u.Bounds);
+
+	a.Height = 1 + FMath::Max(kept.Height, shortNode.Height);
+	u.Height = 1 + FMath::Max(a.Height, tallNode.Height);
+
+	return indexU;
+}
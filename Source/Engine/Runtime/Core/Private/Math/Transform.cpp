@@ -0,0 +1,5 @@
+#pragma once 
+
+#include "Math/Transform.h"
+
+const FTransform FTransform::Identity;
\ No newline at end of file
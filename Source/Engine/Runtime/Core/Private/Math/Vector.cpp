@@ -1,12 +1,60 @@
 #pragma once
 
 #include "Math/Vector.h"
+#include "Math/Vector4.h"
+#include "Math/VectorRegister.h"
 
-const FVector FVector::Zero(0, 0, 0);
-const FVector FVector::One(1, 1, 1);
-const FVector FVector::Right(1, 0, 0);
-const FVector FVector::Left(-1, 0, 0);
-const FVector FVector::Up(0, 1, 0);
-const FVector FVector::Down(0, -1, 0);
-const FVector FVector::Forward(0, 0, 1);
-const FVector FVector::Back(0, 0, -1);
\ No newline at end of file
+namespace
+{
+	/** Calls kernel(a, b, weights) on blocks of four vectors, as three registers of packed components. */
+	template<typename KernelType>
+	void BlendArray(const FVector* a, const FVector* b, FVector* dest, i32 count, float alpha, const float* boneWeights, KernelType&& kernel)
+	{
+		const VectorRegister alphas = VectorSetFloat1(alpha);
+		const i32 numBlocked = count - count % 4;
+
+		for (i32 i = 0; i < numBlocked; i += 4)
+		{
+			const float* blockA = a[i].Components;
+			const float* blockB = b[i].Components;
+			float* blockDest = dest[i].Components;
+
+			// Bone weights spread over the components, (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3).
+			const VectorRegister weights = boneWeights ? VectorMultiply(VectorLoad(boneWeights + i), alphas) : alphas;
+			const VectorRegister weights0 = VectorSwizzle<0, 0, 0, 1>(weights);
+			const VectorRegister weights1 = VectorSwizzle<1, 1, 2, 2>(weights);
+			const VectorRegister weights2 = VectorSwizzle<2, 3, 3, 3>(weights);
+
+			const VectorRegister result0 = kernel(VectorLoad(blockA + 0), VectorLoad(blockB + 0), weights0);
+			const VectorRegister result1 = kernel(VectorLoad(blockA + 4), VectorLoad(blockB + 4), weights1);
+			const VectorRegister result2 = kernel(VectorLoad(blockA + 8), VectorLoad(blockB + 8), weights2);
+
+			VectorStore(result0, blockDest + 0);
+			VectorStore(result1, blockDest + 4);
+			VectorStore(result2, blockDest + 8);
+		}
+
+		for (i32 i = numBlocked; i < count; ++i)
+		{
+			const VectorRegister weights = VectorSetFloat1(boneWeights ? boneWeights[i] * alpha : alpha);
+			const FVector4 result(kernel(VectorSet(a[i].X, a[i].Y, a[i].Z, 0.0f), VectorSet(b[i].X, b[i].Y, b[i].Z, 0.0f), weights));
+			dest[i] = FVector(result.X, result.Y, result.Z);
+		}
+	}
+}
+
+void FVector::LerpArray(const FVector* a, const FVector* b, FVector* dest, i32 count, float alpha, const float* boneWeights)
+{
+	BlendArray(a, b, dest, count, alpha, boneWeights, [](VectorRegister from, VectorRegister to, VectorRegister weights)
+	{
+		return VectorMultiplyAdd(VectorSubtract(to, from), weights, from);
+	});
+}
+
+void FVector::ApplyAdditiveArray(const FVector* base, const FVector* additive, FVector* dest, i32 count, float alpha, const float* boneWeights)
+{
+	BlendArray(base, additive, dest, count, alpha, boneWeights, [](VectorRegister from, VectorRegister offset, VectorRegister weights)
+	{
+		return VectorMultiplyAdd(offset, weights, from);
+	});
+}
@@ -1,10 +0,0 @@
-#pragma once
-
-#include "Math/Vector2.h"
-
-const FVector2 FVector2::Zero(0, 0);
-const FVector2 FVector2::One(1, 1);
-const FVector2 FVector2::Right(1, 0);
-const FVector2 FVector2::Left(-1, 0);
-const FVector2 FVector2::Up(0, 1);
-const FVector2 FVector2::Down(0, -1);
\ No newline at end of file
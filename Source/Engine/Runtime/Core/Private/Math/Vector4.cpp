@@ -1,6 +0,0 @@
-#pragma once
-
-#include "Math/Vector4.h"
-
-const FVector4 FVector4::Zero(0, 0, 0, 0);
-const FVector4 FVector4::One(1, 1, 1, 1);
\ No newline at end of file
@@ -0,0 +1,362 @@
+#pragma once
+
+#include "Memory/MallocBinned.h"
+
+namespace
+{
+	CONSTEXPR u8 InvalidSizeClass = 0xFF;
+	CONSTEXPR SIZE_T ThreadCacheBytes = 32 * 1024;
+
+	// 16 byte steps up to 128 bytes, then four steps per power of two up to MaxBinnedSize.
+	struct FSizeClassTable
+	{
+		u32 Sizes[FMallocBinned::NumSizeClasses] = {};
+		u32 MaxCachedCount[FMallocBinned::NumSizeClasses] = {};
+		u8 SizeToClass[(FMallocBinned::MaxBinnedSize >> 4) + 1] = {};
+
+		CONSTEXPR FSizeClassTable()
+		{
+			u32 index = 0;
+			for (u32 size = 16; size <= 128; size += 16)
+			{
+				Sizes[index++] = size;
+			}
+
+			for (u32 powerOfTwo = 128; powerOfTwo < FMallocBinned::MaxBinnedSize; powerOfTwo *= 2)
+			{
+				for (u32 step = 1; step <= 4; ++step)
+				{
+					Sizes[index++] = powerOfTwo + step * (powerOfTwo / 4);
+				}
+			}
+
+			u32 sizeClass = 0;
+			for (u32 slot = 0; slot <= (FMallocBinned::MaxBinnedSize >> 4); ++slot)
+			{
+				while (Sizes[sizeClass] < slot * 16)
+				{
+					++sizeClass;
+				}
+
+				SizeToClass[slot] = (u8)sizeClass;
+			}
+
+			for (u32 i = 0; i < FMallocBinned::NumSizeClasses; ++i)
+			{
+				const u32 count = (u32)(ThreadCacheBytes / Sizes[i]);
+				MaxCachedCount[i] = count < 4 ? 4 : count > 256 ? 256 : count;
+			}
+		}
+	};
+
+	CONSTEXPR FSizeClassTable GSizeClasses;
+
+	static_assert(GSizeClasses.Sizes[FMallocBinned::NumSizeClasses - 1] == FMallocBinned::MaxBinnedSize, "Size class table doesn't end at MaxBinnedSize.");
+
+	FORCEINLINE u8 GetSizeClass(SIZE_T size, u64 alignment)
+	{
+		if (size > FMallocBinned::MaxBinnedSize)
+		{
+			return InvalidSizeClass;
+		}
+
+		u8 sizeClass = GSizeClasses.SizeToClass[(size + 15) >> 4];
+
+		// Blocks are BlockSize aligned, so an element is aligned to every alignment its size class is a multiple of.
+		if (alignment > MIN_ALIGNMENT)
+		{
+			while (sizeClass < FMallocBinned::NumSizeClasses && GSizeClasses.Sizes[sizeClass] % alignment != 0)
+			{
+				++sizeClass;
+			}
+
+			if (sizeClass == FMallocBinned::NumSizeClasses)
+			{
+				return InvalidSizeClass;
+			}
+		}
+
+		return sizeClass;
+	}
+}
+
+struct FMallocBinned::FThreadCache
+{
+	struct FBin
+	{
+		FFreeBlock* Head = nullptr;
+		u32 Count = 0;
+	};
+
+	FMallocBinned* Owner = nullptr;
+	FBin Bins[NumSizeClasses];
+
+	~FThreadCache()
+	{
+		if (Owner != nullptr)
+		{
+			Owner->FlushThreadCache(*this);
+		}
+	}
+};
+
+thread_local FMallocBinned::FThreadCache FMallocBinned::s_ThreadCache;
+
+void* FMallocBinned::Malloc(SIZE_T size, u64 alignment)
+{
+	const u8 sizeClass = GetSizeClass(size, alignment);
+	if (sizeClass == InvalidSizeClass || !InitializeArena())
+	{
+		return FMalloc::Malloc(size, alignment);
+	}
+
+	FThreadCache& cache = s_ThreadCache;
+	if (cache.Owner == nullptr)
+	{
+		cache.Owner = this;
+	}
+
+	// Only one binned allocator owns a thread's cache, any other instance goes straight to its shared bins.
+	if (cache.Owner != this)
+	{
+		FFreeBlock* block = nullptr;
+		if (RefillFromCentral(sizeClass, block, 1) == 0)
+		{
+			return FMalloc::Malloc(size, alignment);
+		}
+
+		return block;
+	}
+
+	FThreadCache::FBin& bin = cache.Bins[sizeClass];
+	if (bin.Head == nullptr)
+	{
+		bin.Count = RefillFromCentral(sizeClass, bin.Head, GSizeClasses.MaxCachedCount[sizeClass] / 2);
+		if (bin.Count == 0)
+		{
+			return FMalloc::Malloc(size, alignment);
+		}
+	}
+
+	FFreeBlock* block = bin.Head;
+	bin.Head = block->Next;
+	--bin.Count;
+	return block;
+}
+
+void* FMallocBinned::Realloc(void* ptr, SIZE_T newSize, u64 alignment)
+{
+	if (ptr == nullptr || newSize == 0 || !IsBinned(ptr))
+	{
+		return FMalloc::Realloc(ptr, newSize, alignment);
+	}
+
+	// Stay in the current size class while it fits and isn't more than twice too big.
+	const SIZE_T elementSize = GSizeClasses.Sizes[GetBlockSizeClass(ptr)];
+	const u64 requiredAlignment = alignment < MIN_ALIGNMENT ? MIN_ALIGNMENT : alignment;
+
+	if (newSize <= elementSize && newSize > elementSize / 2 && ((UPTRINT)ptr & (requiredAlignment - 1)) == 0)
+	{
+		return ptr;
+	}
+
+	void* newPtr = Malloc(newSize, alignment);
+	if (newPtr == nullptr)
+	{
+		return nullptr;
+	}
+
+	memcpy(newPtr, ptr, elementSize < newSize ? elementSize : newSize);
+	Free(ptr);
+	return newPtr;
+}
+
+void FMallocBinned::Free(void* ptr)
+{
+	if (!IsBinned(ptr))
+	{
+		FMalloc::Free(ptr);
+		return;
+	}
+
+	const u8 sizeClass = GetBlockSizeClass(ptr);
+	FFreeBlock* block = (FFreeBlock*)ptr;
+
+	FThreadCache& cache = s_ThreadCache;
+	if (cache.Owner == nullptr)
+	{
+		cache.Owner = this;
+	}
+
+	if (cache.Owner != this)
+	{
+		block->Next = nullptr;
+		ReleaseToCentral(sizeClass, block, block);
+		return;
+	}
+
+	FThreadCache::FBin& bin = cache.Bins[sizeClass];
+	block->Next = bin.Head;
+	bin.Head = block;
+
+	if (++bin.Count < GSizeClasses.MaxCachedCount[sizeClass])
+	{
+		return;
+	}
+
+	// Keep the most recently freed half hot in the cache and hand the rest back in one batch.
+	FFreeBlock* tail = bin.Head;
+	for (u32 i = 1; i < bin.Count / 2; ++i)
+	{
+		tail = tail->Next;
+	}
+
+	FFreeBlock* released = tail->Next;
+	tail->Next = nullptr;
+
+	FFreeBlock* releasedTail = released;
+	while (releasedTail->Next != nullptr)
+	{
+		releasedTail = releasedTail->Next;
+	}
+
+	ReleaseToCentral(sizeClass, released, releasedTail);
+	bin.Count = bin.Count / 2;
+}
+
+bool FMallocBinned::TryGetAllocationSize(void* ptr, SIZE_T& outSize)
+{
+	if (!IsBinned(ptr))
+	{
+		return FMalloc::TryGetAllocationSize(ptr, outSize);
+	}
+
+	outSize = GSizeClasses.Sizes[GetBlockSizeClass(ptr)];
+	return true;
+}
+
+bool FMallocBinned::InitializeArena()
+{
+	if (m_ArenaBase.load(std::memory_order_acquire) != nullptr)
+	{
+		return true;
+	}
+
+	std::call_once(m_InitializeFlag, [this]()
+	{
+		const SIZE_T numBlocks = ArenaSize / BlockSize;
+
+		u8* blockSizeClasses = (u8*)FPlatformMemory::AllocatePages(numBlocks);
+		if (blockSizeClasses == nullptr)
+		{
+			return;
+		}
+
+		u8* arenaBase = (u8*)FPlatformMemory::ReserveAddressSpace(ArenaSize + BlockSize);
+		if (arenaBase == nullptr)
+		{
+			FPlatformMemory::FreePages(blockSizeClasses, numBlocks);
+			return;
+		}
+
+		m_BlockSizeClasses = blockSizeClasses;
+		m_ArenaBase.store(Align(arenaBase, BlockSize), std::memory_order_release);
+	});
+
+	return m_ArenaBase.load(std::memory_order_acquire) != nullptr;
+}
+
+u8* FMallocBinned::AcquireBlock(u32 sizeClass)
+{
+	const SIZE_T blockIndex = m_NextBlock.fetch_add(1, std::memory_order_relaxed);
+	if (blockIndex >= ArenaSize / BlockSize)
+	{
+		return nullptr;
+	}
+
+	u8* block = m_ArenaBase.load(std::memory_order_relaxed) + blockIndex * BlockSize;
+	if (!FPlatformMemory::CommitPages(block, BlockSize))
+	{
+		return nullptr;
+	}
+
+	m_BlockSizeClasses[blockIndex] = (u8)sizeClass;
+	return block;
+}
+
+u32 FMallocBinned::RefillFromCentral(u32 sizeClass, FFreeBlock*& outHead, u32 maxCount)
+{
+	FCentralBin& central = m_CentralBins[sizeClass];
+	const SIZE_T elementSize = GSizeClasses.Sizes[sizeClass];
+
+	std::lock_guard<std::mutex> lock(central.Mutex);
+
+	u32 count = 0;
+	FFreeBlock* head = nullptr;
+
+	while (count < maxCount && central.FreeList != nullptr)
+	{
+		FFreeBlock* block = central.FreeList;
+		central.FreeList = block->Next;
+		block->Next = head;
+		head = block;
+		++count;
+	}
+
+	while (count < maxCount)
+	{
+		if ((SIZE_T)(central.BumpEnd - central.BumpCursor) < elementSize)
+		{
+			u8* block = AcquireBlock(sizeClass);
+			if (block == nullptr)
+			{
+				break;
+			}
+
+			central.BumpCursor = block;
+			central.BumpEnd = block + (BlockSize / elementSize) * elementSize;
+		}
+
+		FFreeBlock* element = (FFreeBlock*)central.BumpCursor;
+		central.BumpCursor += elementSize;
+		element->Next = head;
+		head = element;
+		++count;
+	}
+
+	outHead = head;
+	return count;
+}
+
+void FMallocBinned::ReleaseToCentral(u32 sizeClass, FFreeBlock* head, FFreeBlock* tail)
+{
+	FCentralBin& central = m_CentralBins[sizeClass];
+
+	std::lock_guard<std::mutex> lock(central.Mutex);
+	tail->Next = central.FreeList;
+	central.FreeList = head;
+}
+
+void FMallocBinned::FlushThreadCache(FThreadCache& cache)
+{
+	for (u32 sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+	{
+		FThreadCache::FBin& bin = cache.Bins[sizeClass];
+		if (bin.Head == nullptr)
+		{
+			continue;
+		}
+
+		FFreeBlock* tail = bin.Head;
+		while (tail->Next != nullptr)
+		{
+			tail = tail->Next;
+		}
+
+		ReleaseToCentral(sizeClass, bin.Head, tail);
+		bin.Head = nullptr;
+		bin.Count = 0;
+	}
+
+	cache.Owner = nullptr;
+}
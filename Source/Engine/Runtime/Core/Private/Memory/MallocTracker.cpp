@@ -0,0 +1,554 @@
+#pragma once
+
+#include "Memory/MallocTracker.h"
+
+#include <new>
+#include <thread>
+
+namespace
+{
+	// Sits right before every pointer the tracker returns.
+	// SizeAndInfo packs the requested size (48 bits), the tag (8 bits) and log2 of the offset to the inner allocation (8 bits).
+	struct FAllocationHeader
+	{
+		void* Callsite;
+		u64 SizeAndInfo;
+	};
+
+	static_assert(sizeof(FAllocationHeader) == MIN_ALIGNMENT, "FAllocationHeader must keep returned pointers aligned.");
+
+	CONSTEXPR u64 SizeMask = (1ull << 48) - 1;
+
+	std::atomic<const ANSICHAR*> GTagNames[FMallocTracker::MaxTags];
+	std::atomic<u32> GNumTags(1);
+	std::mutex GTagMutex;
+
+	thread_local u8 GCurrentTag = FMallocTracker::UntaggedTag;
+
+	FORCEINLINE u32 FloorLog2(u64 value)
+	{
+		u32 result = 0;
+		for (u32 shift = 32; shift > 0; shift /= 2)
+		{
+			if (value >= (1ull << shift))
+			{
+				value >>= shift;
+				result += shift;
+			}
+		}
+
+		return result;
+	}
+
+	// Counters are only written by their owning thread, the atomics only make concurrent report reads well defined.
+	FORCEINLINE void Add(std::atomic<u64>& counter, u64 value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	FORCEINLINE void Add(std::atomic<i64>& counter, i64 value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	FORCEINLINE SIZE_T HashCallsite(void* callsite)
+	{
+		UPTRINT value = (UPTRINT)callsite;
+		value ^= value >> 17;
+		value *= (UPTRINT)0x9E3779B97F4A7C15ull;
+		return (SIZE_T)(value >> 7);
+	}
+}
+
+struct FMallocTracker::FThreadStats
+{
+	struct FTagStats
+	{
+		std::atomic<u64> NumAllocations;
+		std::atomic<u64> NumFrees;
+		std::atomic<u64> AllocatedBytes;
+		std::atomic<i64> LiveBytes;
+		std::atomic<u64> SizeHistogram[NumSizeBuckets];
+
+		// Live bytes not yet published to FMallocTracker::m_TagLiveBytes.
+		i64 UnflushedLiveBytes;
+	};
+
+	struct FCallsiteStats
+	{
+		std::atomic<void*> Callsite;
+		std::atomic<u64> NumAllocations;
+		std::atomic<u64> AllocatedBytes;
+		std::atomic<i64> LiveBytes;
+	};
+
+	FTagStats Tags[MaxTags];
+
+	// Slot 0 collects the callsites that didn't find room in the table.
+	FCallsiteStats Callsites[MaxCallsitesPerThread];
+
+	std::thread::id ThreadId;
+	FMallocTracker* Owner;
+	FThreadStats* Next;
+
+	FORCEINLINE FCallsiteStats& FindOrAddCallsite(void* callsite)
+	{
+		CONSTEXPR u32 MaxProbes = 16;
+
+		if (callsite == nullptr)
+		{
+			return Callsites[0];
+		}
+
+		SIZE_T index = HashCallsite(callsite);
+		for (u32 probe = 0; probe < MaxProbes; ++probe, ++index)
+		{
+			FCallsiteStats& stats = Callsites[1 + index % (MaxCallsitesPerThread - 1)];
+			void* current = stats.Callsite.load(std::memory_order_relaxed);
+
+			if (current == callsite)
+			{
+				return stats;
+			}
+
+			if (current == nullptr)
+			{
+				stats.Callsite.store(callsite, std::memory_order_relaxed);
+				return stats;
+			}
+		}
+
+		return Callsites[0];
+	}
+};
+
+thread_local FMallocTracker::FThreadStats* FMallocTracker::s_ThreadStats = nullptr;
+
+FMallocTracker::~FMallocTracker()
+{
+	if (m_bDumpOnShutdown)
+	{
+		DumpReport();
+	}
+}
+
+void* FMallocTracker::Malloc(SIZE_T size, u64 alignment)
+{
+	return TrackedMalloc(size, alignment, PLATFORM_RETURN_ADDRESS());
+}
+
+void* FMallocTracker::Realloc(void* ptr, SIZE_T newSize, u64 alignment)
+{
+	if (ptr == nullptr)
+	{
+		return TrackedMalloc(newSize, alignment, PLATFORM_RETURN_ADDRESS());
+	}
+
+	if (newSize == 0)
+	{
+		Free(ptr);
+		return nullptr;
+	}
+
+	FAllocationHeader* header = (FAllocationHeader*)ptr - 1;
+	const i64 oldSize = (i64)(header->SizeAndInfo & SizeMask);
+	const u8 tag = (u8)(header->SizeAndInfo >> 48);
+	const u64 offset = 1ull << (header->SizeAndInfo >> 56);
+	void* callsite = header->Callsite;
+
+	// A different alignment needs a different header offset, which the inner allocator can't preserve.
+	const u64 newOffset = alignment > sizeof(FAllocationHeader) ? alignment : sizeof(FAllocationHeader);
+	if (newOffset != offset)
+	{
+		void* newPtr = TrackedMalloc(newSize, alignment, callsite);
+		if (newPtr != nullptr)
+		{
+			memcpy(newPtr, ptr, (SIZE_T)oldSize < newSize ? (SIZE_T)oldSize : newSize);
+			Free(ptr);
+		}
+
+		return newPtr;
+	}
+
+	u8* base = (u8*)m_Inner->Realloc((u8*)ptr - offset, newSize + offset, alignment);
+	if (base == nullptr)
+	{
+		return nullptr;
+	}
+
+	CHECK(newSize <= SizeMask);
+
+	u8* newPtr = base + offset;
+	header = (FAllocationHeader*)newPtr - 1;
+	header->SizeAndInfo = (u64)newSize | ((u64)tag << 48) | ((u64)FloorLog2(offset) << 56);
+
+	// The allocation keeps its tag and callsite, only the size difference is booked.
+	const i64 delta = (i64)newSize - oldSize;
+
+	FThreadStats& stats = GetThreadStats();
+	FThreadStats::FCallsiteStats& callsiteStats = stats.FindOrAddCallsite(callsite);
+	Add(callsiteStats.LiveBytes, delta);
+
+	if (delta > 0)
+	{
+		Add(stats.Tags[tag].AllocatedBytes, (u64)delta);
+		Add(callsiteStats.AllocatedBytes, (u64)delta);
+	}
+
+	AddLiveBytes(stats, tag, delta);
+	return newPtr;
+}
+
+void* FMallocTracker::TrackedMalloc(SIZE_T size, u64 alignment, void* callsite)
+{
+	const u64 offset = alignment > sizeof(FAllocationHeader) ? alignment : sizeof(FAllocationHeader);
+
+	u8* base = (u8*)m_Inner->Malloc(size + offset, alignment);
+	if (base == nullptr)
+	{
+		return nullptr;
+	}
+
+	CHECK(size <= SizeMask);
+
+	const u8 tag = GCurrentTag;
+	u8* ptr = base + offset;
+
+	FAllocationHeader* header = (FAllocationHeader*)ptr - 1;
+	header->Callsite = callsite;
+	header->SizeAndInfo = (u64)size | ((u64)tag << 48) | ((u64)FloorLog2(offset) << 56);
+
+	FThreadStats& stats = GetThreadStats();
+
+	FThreadStats::FTagStats& tagStats = stats.Tags[tag];
+	Add(tagStats.NumAllocations, 1);
+	Add(tagStats.AllocatedBytes, size);
+	Add(tagStats.SizeHistogram[size == 0 ? 0 : FMath::Min(FloorLog2(size), NumSizeBuckets - 1)], 1);
+
+	FThreadStats::FCallsiteStats& callsiteStats = stats.FindOrAddCallsite(callsite);
+	Add(callsiteStats.NumAllocations, 1);
+	Add(callsiteStats.AllocatedBytes, size);
+	Add(callsiteStats.LiveBytes, (i64)size);
+
+	AddLiveBytes(stats, tag, (i64)size);
+	return ptr;
+}
+
+void FMallocTracker::Free(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	FAllocationHeader* header = (FAllocationHeader*)ptr - 1;
+	const i64 size = (i64)(header->SizeAndInfo & SizeMask);
+	const u8 tag = (u8)(header->SizeAndInfo >> 48);
+	const u64 offset = 1ull << (header->SizeAndInfo >> 56);
+
+	// Frees are booked on the freeing thread, live values only add up once all threads are summed.
+	FThreadStats& stats = GetThreadStats();
+	Add(stats.Tags[tag].NumFrees, 1);
+	Add(stats.FindOrAddCallsite(header->Callsite).LiveBytes, -size);
+	AddLiveBytes(stats, tag, -size);
+
+	m_Inner->Free((u8*)ptr - offset);
+}
+
+bool FMallocTracker::TryGetAllocationSize(void* ptr, SIZE_T& outSize)
+{
+	if (ptr == nullptr)
+	{
+		return false;
+	}
+
+	FAllocationHeader* header = (FAllocationHeader*)ptr - 1;
+	const u64 offset = 1ull << (header->SizeAndInfo >> 56);
+
+	SIZE_T innerSize;
+	if (!m_Inner->TryGetAllocationSize((u8*)ptr - offset, innerSize))
+	{
+		return false;
+	}
+
+	outSize = innerSize - (SIZE_T)offset;
+	return true;
+}
+
+u8 FMallocTracker::RegisterTag(const ANSICHAR* name)
+{
+	std::lock_guard<std::mutex> lock(GTagMutex);
+
+	const u32 numTags = GNumTags.load(std::memory_order_relaxed);
+	for (u32 tag = 1; tag < numTags; ++tag)
+	{
+		const ANSICHAR* tagName = GTagNames[tag].load(std::memory_order_relaxed);
+
+		u32 i = 0;
+		while (tagName[i] == name[i] && name[i] != 0)
+		{
+			++i;
+		}
+
+		if (tagName[i] == name[i])
+		{
+			return (u8)tag;
+		}
+	}
+
+	if (numTags == MaxTags)
+	{
+		return UntaggedTag;
+	}
+
+	GTagNames[numTags].store(name, std::memory_order_relaxed);
+	GNumTags.store(numTags + 1, std::memory_order_release);
+	return (u8)numTags;
+}
+
+u8 FMallocTracker::GetCurrentTag()
+{
+	return GCurrentTag;
+}
+
+u8 FMallocTracker::SetCurrentTag(u8 tag)
+{
+	const u8 previousTag = GCurrentTag;
+	GCurrentTag = tag;
+	return previousTag;
+}
+
+u32 FMallocTracker::GatherTagReports(FTagReport* outTags) const
+{
+	const u32 numTags = GNumTags.load(std::memory_order_acquire);
+
+	for (u32 tag = 0; tag < MaxTags; ++tag)
+	{
+		FTagReport& report = outTags[tag];
+		report = {};
+		report.Name = tag == UntaggedTag ? "Untagged" : GTagNames[tag].load(std::memory_order_relaxed);
+		report.PeakLiveBytes = m_TagPeakLiveBytes[tag].load(std::memory_order_relaxed);
+	}
+
+	std::lock_guard<std::mutex> lock(m_ThreadStatsMutex);
+
+	for (const FThreadStats* stats = m_ThreadStatsList; stats != nullptr; stats = stats->Next)
+	{
+		for (u32 tag = 0; tag < numTags; ++tag)
+		{
+			const FThreadStats::FTagStats& tagStats = stats->Tags[tag];
+			FTagReport& report = outTags[tag];
+
+			report.NumAllocations += tagStats.NumAllocations.load(std::memory_order_relaxed);
+			report.NumFrees += tagStats.NumFrees.load(std::memory_order_relaxed);
+			report.AllocatedBytes += tagStats.AllocatedBytes.load(std::memory_order_relaxed);
+			report.LiveBytes += tagStats.LiveBytes.load(std::memory_order_relaxed);
+
+			for (u32 bucket = 0; bucket < NumSizeBuckets; ++bucket)
+			{
+				report.SizeHistogram[bucket] += tagStats.SizeHistogram[bucket].load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// The published peak lags the exact live value, never report it below the live bytes just summed.
+	for (u32 tag = 0; tag < numTags; ++tag)
+	{
+		outTags[tag].PeakLiveBytes = FMath::Max(outTags[tag].PeakLiveBytes, outTags[tag].LiveBytes);
+	}
+
+	return numTags;
+}
+
+u32 FMallocTracker::GatherCallsiteReports(FCallsiteReport* outCallsites, u32 maxCallsites) const
+{
+	std::lock_guard<std::mutex> lock(m_ThreadStatsMutex);
+
+	u32 numThreads = 0;
+	for (const FThreadStats* stats = m_ThreadStatsList; stats != nullptr; stats = stats->Next)
+	{
+		++numThreads;
+	}
+
+	struct FMergedCallsite
+	{
+		FCallsiteReport Report;
+		bool bUsed;
+	};
+
+	// Merge every thread's table into one open addressing table with at most 50% load.
+	SIZE_T capacity = 1;
+	while (capacity < (SIZE_T)numThreads * MaxCallsitesPerThread * 2)
+	{
+		capacity *= 2;
+	}
+
+	const SIZE_T mergedSize = capacity * sizeof(FMergedCallsite);
+	FMergedCallsite* merged = (FMergedCallsite*)FPlatformMemory::AllocatePages(mergedSize);
+	if (merged == nullptr)
+	{
+		return 0;
+	}
+
+	for (const FThreadStats* stats = m_ThreadStatsList; stats != nullptr; stats = stats->Next)
+	{
+		for (u32 i = 0; i < MaxCallsitesPerThread; ++i)
+		{
+			const FThreadStats::FCallsiteStats& callsiteStats = stats->Callsites[i];
+			void* callsite = callsiteStats.Callsite.load(std::memory_order_relaxed);
+			if (callsite == nullptr && (i != 0 || callsiteStats.NumAllocations.load(std::memory_order_relaxed) == 0))
+			{
+				continue;
+			}
+
+			SIZE_T index = HashCallsite(callsite) & (capacity - 1);
+			while (merged[index].bUsed && merged[index].Report.Callsite != callsite)
+			{
+				index = (index + 1) & (capacity - 1);
+			}
+
+			merged[index].bUsed = true;
+
+			FCallsiteReport& report = merged[index].Report;
+			report.Callsite = callsite;
+			report.NumAllocations += callsiteStats.NumAllocations.load(std::memory_order_relaxed);
+			report.AllocatedBytes += callsiteStats.AllocatedBytes.load(std::memory_order_relaxed);
+			report.LiveBytes += callsiteStats.LiveBytes.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Selection of the top entries, maxCallsites is expected to be small.
+	u32 numWritten = 0;
+	for (; numWritten < maxCallsites; ++numWritten)
+	{
+		FMergedCallsite* best = nullptr;
+		for (SIZE_T i = 0; i < capacity; ++i)
+		{
+			if (merged[i].bUsed && (best == nullptr || merged[i].Report.NumAllocations > best->Report.NumAllocations))
+			{
+				best = &merged[i];
+			}
+		}
+
+		if (best == nullptr)
+		{
+			break;
+		}
+
+		outCallsites[numWritten] = best->Report;
+		best->bUsed = false;
+	}
+
+	FPlatformMemory::FreePages(merged, mergedSize);
+	return numWritten;
+}
+
+void FMallocTracker::DumpReport(FILE* file, u32 maxCallsites) const
+{
+	FTagReport tags[MaxTags];
+	const u32 numTags = GatherTagReports(tags);
+
+	fprintf(file, "Memory report by tag:\n");
+	fprintf(file, "%-24s %14s %14s %16s %16s %16s\n", "Tag", "Allocs", "Frees", "Allocated", "Live", "Peak");
+
+	for (u32 tag = 0; tag < numTags; ++tag)
+	{
+		const FTagReport& report = tags[tag];
+		if (report.NumAllocations == 0 && report.NumFrees == 0)
+		{
+			continue;
+		}
+
+		fprintf(file, "%-24s %14llu %14llu %16llu %16lld %16lld\n", report.Name,
+			(unsigned long long)report.NumAllocations, (unsigned long long)report.NumFrees,
+			(unsigned long long)report.AllocatedBytes, (long long)report.LiveBytes, (long long)report.PeakLiveBytes);
+
+		for (u32 bucket = 0; bucket < NumSizeBuckets; ++bucket)
+		{
+			if (report.SizeHistogram[bucket] != 0)
+			{
+				fprintf(file, "    [%llu, %llu) bytes: %llu\n", bucket == 0 ? 0ull : 1ull << bucket, 1ull << (bucket + 1),
+					(unsigned long long)report.SizeHistogram[bucket]);
+			}
+		}
+	}
+
+	if (maxCallsites == 0)
+	{
+		return;
+	}
+
+	FCallsiteReport* callsites = (FCallsiteReport*)FPlatformMemory::AllocatePages(maxCallsites * sizeof(FCallsiteReport));
+	if (callsites == nullptr)
+	{
+		return;
+	}
+
+	const u32 numCallsites = GatherCallsiteReports(callsites, maxCallsites);
+
+	fprintf(file, "Top %u callsites by allocation count:\n", numCallsites);
+	fprintf(file, "%-18s %14s %16s %16s\n", "Callsite", "Allocs", "Allocated", "Live");
+
+	for (u32 i = 0; i < numCallsites; ++i)
+	{
+		const FCallsiteReport& report = callsites[i];
+		fprintf(file, "%-18p %14llu %16llu %16lld\n", report.Callsite,
+			(unsigned long long)report.NumAllocations, (unsigned long long)report.AllocatedBytes, (long long)report.LiveBytes);
+	}
+
+	FPlatformMemory::FreePages(callsites, maxCallsites * sizeof(FCallsiteReport));
+}
+
+FMallocTracker::FThreadStats& FMallocTracker::GetThreadStats()
+{
+	FThreadStats* stats = s_ThreadStats;
+	if (stats != nullptr && stats->Owner == this)
+	{
+		return *stats;
+	}
+
+	const std::thread::id threadId = std::this_thread::get_id();
+
+	std::lock_guard<std::mutex> lock(m_ThreadStatsMutex);
+
+	// Threads that go through more than one tracker find their other blocks here.
+	for (stats = m_ThreadStatsList; stats != nullptr; stats = stats->Next)
+	{
+		if (stats->ThreadId == threadId)
+		{
+			s_ThreadStats = stats;
+			return *stats;
+		}
+	}
+
+	// Thread blocks come straight from the platform so tracking never recurses into an FMalloc, and they are
+	// never freed so the counters of exited threads stay in the reports.
+	stats = new (FPlatformMemory::AllocatePages(sizeof(FThreadStats))) FThreadStats();
+	stats->ThreadId = threadId;
+	stats->Owner = this;
+	stats->Next = m_ThreadStatsList;
+	m_ThreadStatsList = stats;
+
+	s_ThreadStats = stats;
+	return *stats;
+}
+
+void FMallocTracker::AddLiveBytes(FThreadStats& stats, u8 tag, i64 delta)
+{
+	FThreadStats::FTagStats& tagStats = stats.Tags[tag];
+	Add(tagStats.LiveBytes, delta);
+
+	tagStats.UnflushedLiveBytes += delta;
+	if (tagStats.UnflushedLiveBytes < LiveBytesFlushThreshold && tagStats.UnflushedLiveBytes > -LiveBytesFlushThreshold)
+	{
+		return;
+	}
+
+	const i64 liveBytes = m_TagLiveBytes[tag].fetch_add(tagStats.UnflushedLiveBytes, std::memory_order_relaxed) + tagStats.UnflushedLiveBytes;
+	tagStats.UnflushedLiveBytes = 0;
+
+	i64 peakLiveBytes = m_TagPeakLiveBytes[tag].load(std::memory_order_relaxed);
+	while (liveBytes > peakLiveBytes && !m_TagPeakLiveBytes[tag].compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+	{
+	}
+}
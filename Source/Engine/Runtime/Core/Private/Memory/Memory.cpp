@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Memory/Memory.h"
+#include "Memory/MallocBinned.h"
+#include "Memory/MallocTracker.h"
+
+#if USE_MALLOC_BINNED
+static FMallocBinned GMallocBinned;
+static FMalloc* const GMallocBase = &GMallocBinned;
+#else
+static FMalloc GMallocDefault;
+static FMalloc* const GMallocBase = &GMallocDefault;
+#endif
+
+#if USE_MALLOC_TRACKER
+static FMallocTracker GMallocTracker(GMallocBase, true);
+FMalloc* GMalloc = &GMallocTracker;
+#else
+FMalloc* GMalloc = GMallocBase;
+#endif
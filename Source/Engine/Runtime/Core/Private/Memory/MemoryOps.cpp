@@ -0,0 +1,314 @@
+#pragma once
+
+#include "Memory/MemoryOps.h"
+#include "HAL/PlatformMisc.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+	#include <immintrin.h>
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define TARGET_AVX2 __attribute__((target("avx2")))
+	#else
+		#define TARGET_AVX2
+	#endif
+#endif
+
+namespace
+{
+	SIZE_T GStreamingThreshold = MEMORY_STREAMING_THRESHOLD;
+
+	void* LibcMemcpy(void* dest, const void* src, SIZE_T size)
+	{
+		return memcpy(dest, src, size);
+	}
+
+	void* LibcMemset(void* dest, u8 value, SIZE_T size)
+	{
+		return memset(dest, value, size);
+	}
+
+#if PLATFORM_CPU_X86_FAMILY
+
+	/*--------------------------------------------------------------------------*/
+
+	// The kernels are only called for more than FMemory::SmallSize bytes, so the first and last 64 bytes can
+	// always be written with unaligned accesses that may overlap the main loop.
+
+	void* MemcpySSE2(void* dest, const void* src, SIZE_T size)
+	{
+		u8* d = (u8*)dest;
+		const u8* s = (const u8*)src;
+
+		const __m128i tail0 = _mm_loadu_si128((const __m128i*)(s + size - 64));
+		const __m128i tail1 = _mm_loadu_si128((const __m128i*)(s + size - 48));
+		const __m128i tail2 = _mm_loadu_si128((const __m128i*)(s + size - 32));
+		const __m128i tail3 = _mm_loadu_si128((const __m128i*)(s + size - 16));
+		u8* const tailDest = d + size - 64;
+
+		const bool bStream = size >= GStreamingThreshold;
+
+		// Streaming stores have to be aligned; the bytes skipped here are covered by a first unaligned store.
+		_mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+		const SIZE_T skip = 16 - ((UPTRINT)d & 15);
+		d += skip;
+		s += skip;
+		size -= skip;
+
+		if (bStream)
+		{
+			for (; size > 64; size -= 64, d += 64, s += 64)
+			{
+				const __m128i a = _mm_loadu_si128((const __m128i*)(s + 0));
+				const __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+				const __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+				const __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+				_mm_stream_si128((__m128i*)(d + 0), a);
+				_mm_stream_si128((__m128i*)(d + 16), b);
+				_mm_stream_si128((__m128i*)(d + 32), c);
+				_mm_stream_si128((__m128i*)(d + 48), e);
+			}
+
+			_mm_sfence();
+		}
+		else
+		{
+			for (; size > 64; size -= 64, d += 64, s += 64)
+			{
+				const __m128i a = _mm_loadu_si128((const __m128i*)(s + 0));
+				const __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+				const __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+				const __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+				_mm_store_si128((__m128i*)(d + 0), a);
+				_mm_store_si128((__m128i*)(d + 16), b);
+				_mm_store_si128((__m128i*)(d + 32), c);
+				_mm_store_si128((__m128i*)(d + 48), e);
+			}
+		}
+
+		_mm_storeu_si128((__m128i*)(tailDest + 0), tail0);
+		_mm_storeu_si128((__m128i*)(tailDest + 16), tail1);
+		_mm_storeu_si128((__m128i*)(tailDest + 32), tail2);
+		_mm_storeu_si128((__m128i*)(tailDest + 48), tail3);
+		return dest;
+	}
+
+	void* MemsetSSE2(void* dest, u8 value, SIZE_T size)
+	{
+		u8* d = (u8*)dest;
+		const __m128i v = _mm_set1_epi8((char)value);
+
+		u8* const tailDest = d + size - 64;
+		const bool bStream = size >= GStreamingThreshold;
+
+		_mm_storeu_si128((__m128i*)d, v);
+		const SIZE_T skip = 16 - ((UPTRINT)d & 15);
+		d += skip;
+		size -= skip;
+
+		if (bStream)
+		{
+			for (; size > 64; size -= 64, d += 64)
+			{
+				_mm_stream_si128((__m128i*)(d + 0), v);
+				_mm_stream_si128((__m128i*)(d + 16), v);
+				_mm_stream_si128((__m128i*)(d + 32), v);
+				_mm_stream_si128((__m128i*)(d + 48), v);
+			}
+
+			_mm_sfence();
+		}
+		else
+		{
+			for (; size > 64; size -= 64, d += 64)
+			{
+				_mm_store_si128((__m128i*)(d + 0), v);
+				_mm_store_si128((__m128i*)(d + 16), v);
+				_mm_store_si128((__m128i*)(d + 32), v);
+				_mm_store_si128((__m128i*)(d + 48), v);
+			}
+		}
+
+		_mm_storeu_si128((__m128i*)(tailDest + 0), v);
+		_mm_storeu_si128((__m128i*)(tailDest + 16), v);
+		_mm_storeu_si128((__m128i*)(tailDest + 32), v);
+		_mm_storeu_si128((__m128i*)(tailDest + 48), v);
+		return dest;
+	}
+
+	/*--------------------------------------------------------------------------*/
+
+	TARGET_AVX2 void* MemcpyAVX2(void* dest, const void* src, SIZE_T size)
+	{
+		u8* d = (u8*)dest;
+		const u8* s = (const u8*)src;
+
+		const __m256i tail0 = _mm256_loadu_si256((const __m256i*)(s + size - 64));
+		const __m256i tail1 = _mm256_loadu_si256((const __m256i*)(s + size - 32));
+		u8* const tailDest = d + size - 64;
+
+		const bool bStream = size >= GStreamingThreshold;
+
+		_mm256_storeu_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+		const SIZE_T skip = 32 - ((UPTRINT)d & 31);
+		d += skip;
+		s += skip;
+		size -= skip;
+
+		if (bStream)
+		{
+			for (; size > 128; size -= 128, d += 128, s += 128)
+			{
+				const __m256i a = _mm256_loadu_si256((const __m256i*)(s + 0));
+				const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+				const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+				const __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+				_mm256_stream_si256((__m256i*)(d + 0), a);
+				_mm256_stream_si256((__m256i*)(d + 32), b);
+				_mm256_stream_si256((__m256i*)(d + 64), c);
+				_mm256_stream_si256((__m256i*)(d + 96), e);
+			}
+
+			for (; size > 64; size -= 32, d += 32, s += 32)
+			{
+				_mm256_stream_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+			}
+
+			_mm_sfence();
+		}
+		else
+		{
+			for (; size > 128; size -= 128, d += 128, s += 128)
+			{
+				const __m256i a = _mm256_loadu_si256((const __m256i*)(s + 0));
+				const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+				const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+				const __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+				_mm256_store_si256((__m256i*)(d + 0), a);
+				_mm256_store_si256((__m256i*)(d + 32), b);
+				_mm256_store_si256((__m256i*)(d + 64), c);
+				_mm256_store_si256((__m256i*)(d + 96), e);
+			}
+
+			for (; size > 64; size -= 32, d += 32, s += 32)
+			{
+				_mm256_store_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+			}
+		}
+
+		_mm256_storeu_si256((__m256i*)(tailDest + 0), tail0);
+		_mm256_storeu_si256((__m256i*)(tailDest + 32), tail1);
+		return dest;
+	}
+
+	TARGET_AVX2 void* MemsetAVX2(void* dest, u8 value, SIZE_T size)
+	{
+		u8* d = (u8*)dest;
+		const __m256i v = _mm256_set1_epi8((char)value);
+
+		u8* const tailDest = d + size - 64;
+		const bool bStream = size >= GStreamingThreshold;
+
+		_mm256_storeu_si256((__m256i*)d, v);
+		const SIZE_T skip = 32 - ((UPTRINT)d & 31);
+		d += skip;
+		size -= skip;
+
+		if (bStream)
+		{
+			for (; size > 64; size -= 32, d += 32)
+			{
+				_mm256_stream_si256((__m256i*)d, v);
+			}
+
+			_mm_sfence();
+		}
+		else
+		{
+			for (; size > 64; size -= 32, d += 32)
+			{
+				_mm256_store_si256((__m256i*)d, v);
+			}
+		}
+
+		_mm256_storeu_si256((__m256i*)(tailDest + 0), v);
+		_mm256_storeu_si256((__m256i*)(tailDest + 32), v);
+		return dest;
+	}
+
+#endif
+
+	/*--------------------------------------------------------------------------*/
+
+	// The kernels start out as these, which pick the best implementation and replace themselves.
+
+	void* ResolveMemcpy(void* dest, const void* src, SIZE_T size);
+	void* ResolveMemset(void* dest, u8 value, SIZE_T size);
+
+	void SelectKernels();
+}
+
+std::atomic<FMemory::FMemcpyFunction> FMemory::s_MemcpyKernel(&ResolveMemcpy);
+std::atomic<FMemory::FMemsetFunction> FMemory::s_MemsetKernel(&ResolveMemset);
+
+namespace
+{
+	void SelectKernels()
+	{
+		FMemory::FMemcpyFunction memcpyKernel = &LibcMemcpy;
+		FMemory::FMemsetFunction memsetKernel = &LibcMemset;
+
+#if PLATFORM_CPU_X86_FAMILY
+		if (FPlatformMisc::HasCPUFeature(ECPUFeature::AVX2))
+		{
+			memcpyKernel = &MemcpyAVX2;
+			memsetKernel = &MemsetAVX2;
+		}
+		else if (FPlatformMisc::HasCPUFeature(ECPUFeature::SSE2))
+		{
+			memcpyKernel = &MemcpySSE2;
+			memsetKernel = &MemsetSSE2;
+		}
+#endif
+
+		FMemory::SetKernels(memcpyKernel, memsetKernel);
+	}
+
+	void* ResolveMemcpy(void* dest, const void* src, SIZE_T size)
+	{
+		SelectKernels();
+		return FMemory::Memcpy(dest, src, size);
+	}
+
+	void* ResolveMemset(void* dest, u8 value, SIZE_T size)
+	{
+		SelectKernels();
+		return FMemory::Memset(dest, value, size);
+	}
+
+	// Selects the kernels during static initialization so the first copy doesn't pay for it.
+	struct FKernelSelector
+	{
+		FKernelSelector()
+		{
+			SelectKernels();
+		}
+	};
+
+	FKernelSelector GKernelSelector;
+}
+
+void FMemory::SetStreamingThreshold(SIZE_T size)
+{
+	GStreamingThreshold = size > SmallSize ? size : SmallSize + 1;
+}
+
+SIZE_T FMemory::GetStreamingThreshold()
+{
+	return GStreamingThreshold;
+}
+
+void FMemory::SetKernels(FMemcpyFunction memcpyKernel, FMemsetFunction memsetKernel)
+{
+	s_MemcpyKernel.store(memcpyKernel, std::memory_order_relaxed);
+	s_MemsetKernel.store(memsetKernel, std::memory_order_relaxed);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+#include <thread>
+
+/**
+ * Calls body(begin, end) over contiguous ranges covering [0, count), spread across the hardware threads.
+ * Ranges hold at least minBatchSize items, so small counts run on the calling thread without spawning
+ * anything. Threads are started per call, which only pays off for work in the order of a millisecond or
+ * more; body must be safe to call concurrently on disjoint ranges.
+ */
+template<typename FunctionType>
+void ParallelFor(i32 count, i32 minBatchSize, FunctionType&& body)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	const i32 maxThreads = (i32)std::thread::hardware_concurrency();
+	i32 numBatches = minBatchSize > 0 ? count / minBatchSize : count;
+	numBatches = numBatches < maxThreads ? numBatches : maxThreads;
+
+	if (numBatches <= 1)
+	{
+		body(0, count);
+		return;
+	}
+
+	constexpr i32 MaxBatches = 64;
+	numBatches = numBatches < MaxBatches ? numBatches : MaxBatches;
+
+	std::thread workers[MaxBatches - 1];
+	const i32 batchSize = count / numBatches;
+	const i32 remainder = count % numBatches;
+
+	// The first remainder batches take one extra item. The calling thread runs the last batch.
+	i32 begin = 0;
+	for (i32 batch = 0; batch < numBatches - 1; ++batch)
+	{
+		const i32 end = begin + batchSize + (batch < remainder ? 1 : 0);
+		workers[batch] = std::thread([&body, begin, end]() { body(begin, end); });
+		begin = end;
+	}
+
+	body(begin, count);
+
+	for (i32 batch = 0; batch < numBatches - 1; ++batch)
+	{
+		workers[batch].join();
+	}
+}
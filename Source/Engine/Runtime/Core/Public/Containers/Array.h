@@ -0,0 +1,345 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Memory/Memory.h"
+#include "Memory/MemoryOps.h"
+#include "TypeTraits.h"
+
+#include <initializer_list>
+#include <new>
+
+/**
+ * Contiguous growable array. Storage comes from an allocator policy providing Allocate, Reallocate, Free
+ * and GetAllocationSize (see FHeapAllocator).
+ * Capacity always reflects the usable size the allocator reports, so slack the allocator rounds up to is used
+ * before growing again. When the policy allows reallocation and T is trivially relocatable, growth goes through
+ * Reallocate and can happen in place.
+ */
+template<typename T, typename Allocator = FHeapAllocator>
+class TArray
+{
+public:
+
+	typedef T ElementType;
+	typedef Allocator AllocatorType;
+
+public:
+
+	FORCEINLINE TArray() : m_Data(nullptr), m_Num(0), m_Max(0) { }
+
+	FORCEINLINE TArray(std::initializer_list<T> list) : TArray()
+	{
+		Append(list.begin(), (i32)list.size());
+	}
+
+	FORCEINLINE TArray(const TArray& other) : TArray()
+	{
+		CopyFrom(other);
+	}
+
+	FORCEINLINE TArray(TArray&& other) : m_Data(other.m_Data), m_Num(other.m_Num), m_Max(other.m_Max)
+	{
+		other.m_Data = nullptr;
+		other.m_Num = 0;
+		other.m_Max = 0;
+	}
+
+	FORCEINLINE ~TArray()
+	{
+		DestructRange(0, m_Num);
+		m_Allocator.Free(m_Data);
+	}
+
+public:
+
+	FORCEINLINE TArray& operator=(const TArray& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			CopyFrom(other);
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE TArray& operator=(TArray&& other)
+	{
+		if (this != &other)
+		{
+			DestructRange(0, m_Num);
+			m_Allocator.Free(m_Data);
+
+			m_Data = other.m_Data;
+			m_Num = other.m_Num;
+			m_Max = other.m_Max;
+
+			other.m_Data = nullptr;
+			other.m_Num = 0;
+			other.m_Max = 0;
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE bool operator==(const TArray& other) const
+	{
+		return m_Num == other.m_Num && FMemory::CompareItems(m_Data, other.m_Data, m_Num);
+	}
+
+	FORCEINLINE bool operator!=(const TArray& other) const
+	{
+		return !(*this == other);
+	}
+
+	FORCEINLINE T& operator[](i32 index)
+	{
+		CHECK(IsValidIndex(index));
+		return m_Data[index];
+	}
+
+	FORCEINLINE const T& operator[](i32 index) const
+	{
+		CHECK(IsValidIndex(index));
+		return m_Data[index];
+	}
+
+public:
+
+	FORCEINLINE i32 Num() const { return m_Num; }
+	FORCEINLINE i32 Max() const { return m_Max; }
+	FORCEINLINE bool IsEmpty() const { return m_Num == 0; }
+	FORCEINLINE bool IsValidIndex(i32 index) const { return index >= 0 && index < m_Num; }
+
+	FORCEINLINE T* GetData() { return m_Data; }
+	FORCEINLINE const T* GetData() const { return m_Data; }
+
+	FORCEINLINE T& Last() { CHECK(m_Num > 0); return m_Data[m_Num - 1]; }
+	FORCEINLINE const T& Last() const { CHECK(m_Num > 0); return m_Data[m_Num - 1]; }
+
+	FORCEINLINE T* begin() { return m_Data; }
+	FORCEINLINE T* end() { return m_Data + m_Num; }
+	FORCEINLINE const T* begin() const { return m_Data; }
+	FORCEINLINE const T* end() const { return m_Data + m_Num; }
+
+public:
+
+	template<typename... ArgTypes>
+	FORCEINLINE T& Emplace(ArgTypes&&... args)
+	{
+		if (m_Num < m_Max)
+		{
+			return *new (m_Data + m_Num++) T(Forward<ArgTypes>(args)...);
+		}
+
+		// The arguments may reference an element of this array, build the value before the storage moves.
+		T value(Forward<ArgTypes>(args)...);
+		ResizeTo(CalculateGrowth(m_Num + 1));
+		return *new (m_Data + m_Num++) T(MoveTemp(value));
+	}
+
+	FORCEINLINE i32 Add(const T& value)
+	{
+		Emplace(value);
+		return m_Num - 1;
+	}
+
+	FORCEINLINE i32 Add(T&& value)
+	{
+		Emplace(MoveTemp(value));
+		return m_Num - 1;
+	}
+
+	/** Appends count elements without constructing them and returns the index of the first one. */
+	FORCEINLINE i32 AddUninitialized(i32 count)
+	{
+		CHECK(count >= 0);
+
+		const i32 index = m_Num;
+		if (m_Num + count > m_Max)
+		{
+			ResizeTo(CalculateGrowth(m_Num + count));
+		}
+
+		m_Num += count;
+		return index;
+	}
+
+	FORCEINLINE i32 AddDefaulted(i32 count = 1)
+	{
+		const i32 index = AddUninitialized(count);
+		FMemory::DefaultConstructItems<T>(m_Data + index, count);
+		return index;
+	}
+
+	FORCEINLINE void Append(const T* values, i32 count)
+	{
+		const i32 index = AddUninitialized(count);
+		FMemory::ConstructItems(m_Data + index, values, count);
+	}
+
+	FORCEINLINE T Pop()
+	{
+		CHECK(m_Num > 0);
+
+		T value(MoveTemp(m_Data[m_Num - 1]));
+		DestructRange(m_Num - 1, m_Num);
+		--m_Num;
+		return value;
+	}
+
+	/** Removes the element at index and shifts the following ones down, keeping their order. */
+	FORCEINLINE void RemoveAt(i32 index)
+	{
+		CHECK(IsValidIndex(index));
+
+		FMemory::DestructItems(m_Data + index, 1);
+		FMemory::RelocateItems(m_Data + index, m_Data + index + 1, m_Num - index - 1);
+		--m_Num;
+	}
+
+	/** Removes the element at index by moving the last element into its place. */
+	FORCEINLINE void RemoveAtSwap(i32 index)
+	{
+		CHECK(IsValidIndex(index));
+
+		FMemory::DestructItems(m_Data + index, 1);
+		if (index != m_Num - 1)
+		{
+			FMemory::RelocateItems(m_Data + index, m_Data + m_Num - 1, 1);
+		}
+
+		--m_Num;
+	}
+
+	FORCEINLINE i32 Find(const T& value) const
+	{
+		for (i32 i = 0; i < m_Num; ++i)
+		{
+			if (m_Data[i] == value)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCEINLINE bool Contains(const T& value) const
+	{
+		return Find(value) != -1;
+	}
+
+public:
+
+	FORCEINLINE void Reserve(i32 count)
+	{
+		if (count > m_Max)
+		{
+			ResizeTo(count);
+		}
+	}
+
+	FORCEINLINE void SetNum(i32 count)
+	{
+		if (count > m_Num)
+		{
+			AddDefaulted(count - m_Num);
+		}
+		else
+		{
+			DestructRange(count, m_Num);
+			m_Num = count;
+		}
+	}
+
+	/** Destroys all elements but keeps the storage. */
+	FORCEINLINE void Reset()
+	{
+		DestructRange(0, m_Num);
+		m_Num = 0;
+	}
+
+	/** Destroys all elements and resizes the storage to hold slack elements. */
+	FORCEINLINE void Empty(i32 slack = 0)
+	{
+		Reset();
+		if (slack != m_Max)
+		{
+			ResizeTo(slack);
+		}
+	}
+
+	FORCEINLINE void Shrink()
+	{
+		if (m_Num != m_Max)
+		{
+			ResizeTo(m_Num);
+		}
+	}
+
+private:
+
+	CONSTEXPR static bool CanReallocate = Allocator::Traits::IsReallocationAllowed && TIsTriviallyRelocatable<T>::Value;
+	CONSTEXPR static u64 Alignment = alignof(T) > MIN_ALIGNMENT ? alignof(T) : DEFAULT_ALIGNMENT;
+
+	// Grows by 3/8 plus a constant so small arrays skip the first few steps.
+	FORCEINLINE static i32 CalculateGrowth(i32 requiredCount)
+	{
+		return requiredCount + 3 * requiredCount / 8 + 4;
+	}
+
+	void ResizeTo(i32 count)
+	{
+		CHECK(count >= m_Num);
+
+		if (count == 0)
+		{
+			m_Allocator.Free(m_Data);
+			m_Data = nullptr;
+			m_Max = 0;
+			return;
+		}
+
+		const SIZE_T size = (SIZE_T)count * sizeof(T);
+		T* newData;
+
+		if (CanReallocate)
+		{
+			newData = (T*)m_Allocator.Reallocate(m_Data, size, Alignment);
+		}
+		else
+		{
+			newData = (T*)m_Allocator.Allocate(size, Alignment);
+			FMemory::RelocateItems(newData, m_Data, m_Num);
+			m_Allocator.Free(m_Data);
+		}
+
+		CHECK(newData != nullptr);
+
+		m_Data = newData;
+		m_Max = (i32)(m_Allocator.GetAllocationSize(newData, size) / sizeof(T));
+	}
+
+	FORCEINLINE void DestructRange(i32 first, i32 last)
+	{
+		FMemory::DestructItems(m_Data + first, last - first);
+	}
+
+	FORCEINLINE void CopyFrom(const TArray& other)
+	{
+		Reserve(other.m_Num);
+		FMemory::ConstructItems(m_Data, other.m_Data, other.m_Num);
+		m_Num = other.m_Num;
+	}
+
+private:
+
+	T* m_Data;
+	i32 m_Num;
+	i32 m_Max;
+
+	Allocator m_Allocator;
+};
+
+template<typename T> struct TIsTriviallyRelocatable<TArray<T, FHeapAllocator>> : FTrueType { };
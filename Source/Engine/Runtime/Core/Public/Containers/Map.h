@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Containers/Set.h"
+
+template<typename KeyType, typename ValueType>
+struct TPair
+{
+	template<typename KeyArgType, typename ValueArgType>
+	FORCEINLINE TPair(KeyArgType&& key, ValueArgType&& value)
+		: Key(Forward<KeyArgType>(key)), Value(Forward<ValueArgType>(value))
+	{
+	}
+
+	KeyType Key;
+	ValueType Value;
+};
+
+template<typename InKeyType, typename InValueType>
+struct TMapKeyFuncs
+{
+	typedef TPair<InKeyType, InValueType> ElementType;
+	typedef InKeyType KeyType;
+
+	FORCEINLINE static const KeyType& GetKey(const ElementType& element)
+	{
+		return element.Key;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE static bool Matches(const KeyType& key, const ComparableKey& other)
+	{
+		return key == other;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE static u64 GetKeyHash(const ComparableKey& key)
+	{
+		return GetTypeHash(key);
+	}
+};
+
+/**
+ * Unordered map from keys to values, a TSet of TPair keyed on TPair::Key. Iterating yields the pairs.
+ * Like TSet, lookups accept any key type that hashes and compares like KeyType.
+ */
+template<typename KeyType, typename ValueType, typename Allocator = FHeapAllocator>
+class TMap
+{
+public:
+
+	typedef TPair<KeyType, ValueType> ElementType;
+	typedef TSet<ElementType, TMapKeyFuncs<KeyType, ValueType>, Allocator> SetType;
+
+public:
+
+	FORCEINLINE TMap() = default;
+
+	FORCEINLINE TMap(std::initializer_list<ElementType> list)
+	{
+		Reserve((i32)list.size());
+		for (const ElementType& pair : list)
+		{
+			Add(pair.Key, pair.Value);
+		}
+	}
+
+public:
+
+	FORCEINLINE i32 Num() const { return m_Pairs.Num(); }
+	FORCEINLINE bool IsEmpty() const { return m_Pairs.IsEmpty(); }
+
+	FORCEINLINE typename SetType::FIterator begin() { return m_Pairs.begin(); }
+	FORCEINLINE typename SetType::FIterator end() { return m_Pairs.end(); }
+	FORCEINLINE typename SetType::FConstIterator begin() const { return m_Pairs.begin(); }
+	FORCEINLINE typename SetType::FConstIterator end() const { return m_Pairs.end(); }
+
+public:
+
+	/** Sets the value of key, adding the pair if the key isn't in the map yet. */
+	template<typename KeyArgType, typename ValueArgType>
+	FORCEINLINE ValueType& Add(KeyArgType&& key, ValueArgType&& value)
+	{
+		return m_Pairs.Emplace(ElementType(Forward<KeyArgType>(key), Forward<ValueArgType>(value))).Value;
+	}
+
+	/** Returns the value of key, adding a default constructed one if the key isn't in the map yet. */
+	template<typename KeyArgType>
+	FORCEINLINE ValueType& FindOrAdd(KeyArgType&& key)
+	{
+		const u64 hash = GetTypeHash(key);
+		return m_Pairs.FindOrAddByHash(hash, key, Forward<KeyArgType>(key), ValueType()).Value;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE ValueType* Find(const ComparableKey& key)
+	{
+		ElementType* pair = m_Pairs.Find(key);
+		return pair != nullptr ? &pair->Value : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ValueType* Find(const ComparableKey& key) const
+	{
+		const ElementType* pair = m_Pairs.Find(key);
+		return pair != nullptr ? &pair->Value : nullptr;
+	}
+
+	/** Finds by a hash computed earlier with GetTypeHash. */
+	template<typename ComparableKey>
+	FORCEINLINE ValueType* FindByHash(u64 hash, const ComparableKey& key)
+	{
+		ElementType* pair = m_Pairs.FindByHash(hash, key);
+		return pair != nullptr ? &pair->Value : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ValueType* FindByHash(u64 hash, const ComparableKey& key) const
+	{
+		const ElementType* pair = m_Pairs.FindByHash(hash, key);
+		return pair != nullptr ? &pair->Value : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE ValueType& FindChecked(const ComparableKey& key)
+	{
+		ValueType* value = Find(key);
+		CHECK(value != nullptr);
+		return *value;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ValueType& FindChecked(const ComparableKey& key) const
+	{
+		const ValueType* value = Find(key);
+		CHECK(value != nullptr);
+		return *value;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE bool Contains(const ComparableKey& key) const
+	{
+		return m_Pairs.Contains(key);
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE i32 Remove(const ComparableKey& key)
+	{
+		return m_Pairs.Remove(key);
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE i32 RemoveByHash(u64 hash, const ComparableKey& key)
+	{
+		return m_Pairs.RemoveByHash(hash, key);
+	}
+
+public:
+
+	FORCEINLINE void Reserve(i32 count) { m_Pairs.Reserve(count); }
+	FORCEINLINE void Reset() { m_Pairs.Reset(); }
+	FORCEINLINE void Empty(i32 slack = 0) { m_Pairs.Empty(slack); }
+	FORCEINLINE void Shrink() { m_Pairs.Shrink(); }
+
+private:
+
+	SetType m_Pairs;
+};
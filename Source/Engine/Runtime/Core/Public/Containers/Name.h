@@ -0,0 +1,99 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+
+/** Name string with its hash computed at compile time, see the NAME macro. */
+struct FNameLiteral
+{
+public:
+
+	template<i32 N>
+	CONSTEXPR FNameLiteral(const TCHAR (&str)[N]) : Data(str), Len(N - 1), Hash(HashString(str, N - 1)) { }
+
+public:
+
+	/** 64 bit FNV-1a over the characters. Names are case sensitive. */
+	FORCEINLINE static CONSTEXPR u64 HashString(const TCHAR* str, i32 len)
+	{
+		u64 hash = 0xCBF29CE484222325ull;
+		for (i32 i = 0; i < len; ++i)
+		{
+			hash = (hash ^ (u64)(u32)str[i]) * 0x100000001B3ull;
+		}
+
+		return hash;
+	}
+
+public:
+
+	const TCHAR* Data;
+	i32 Len;
+	u64 Hash;
+};
+
+/**
+ * Handle to a string interned in the global name table. Names are compared and hashed by handle, and the string
+ * they refer to lives as long as the process, so ToView never copies.
+ * Lookups of names already in the table don't take any lock; adding a name locks one of NumShards shards.
+ * The default name is None.
+ */
+struct FName
+{
+public:
+
+	CONSTEXPR FName() : m_Index(0) { }
+
+	explicit FName(FStringView view);
+	explicit FName(const TCHAR* str) : FName(FStringView(str)) { }
+	explicit FName(const FNameLiteral& literal);
+
+public:
+
+	FORCEINLINE CONSTEXPR bool operator==(FName other) const { return m_Index == other.m_Index; }
+	FORCEINLINE CONSTEXPR bool operator!=(FName other) const { return m_Index != other.m_Index; }
+
+	/** Orders by handle, which is stable within a run but unrelated to the alphabetical order. */
+	FORCEINLINE CONSTEXPR bool operator<(FName other) const { return m_Index < other.m_Index; }
+
+public:
+
+	FORCEINLINE CONSTEXPR bool IsNone() const { return m_Index == 0; }
+	FORCEINLINE CONSTEXPR u32 GetIndex() const { return m_Index; }
+
+	/** Returns the null terminated string of the name. */
+	FStringView ToView() const;
+
+	/**
+	 * Copies the name into a new FString, which allocates when the name doesn't fit FString's inline storage.
+	 * Use ToView, or AppendString into a string with enough capacity, to avoid the allocation.
+	 */
+	FORCEINLINE FString ToString() const { return FString(ToView()); }
+
+	/** Appends the name to out, only allocating if out has to grow. */
+	FORCEINLINE void AppendString(FString& out) const { out.Append(ToView()); }
+
+	/** Returns the name with the given handle, or None if no name has it. */
+	static FName FromIndex(u32 index);
+
+	static u32 GetNumNames();
+
+private:
+
+	u32 m_Index;
+};
+
+FORCEINLINE u64 GetTypeHash(FName name)
+{
+	return GetTypeHash(name.GetIndex());
+}
+
+/** Creates a name from a string literal. The hash is computed at compile time and the lookup only happens on first use. */
+#define NAME(Text) \
+	([]() -> FName \
+	{ \
+		static CONSTEXPR FNameLiteral Literal(TEXT(Text)); \
+		static const FName Name(Literal); \
+		return Name; \
+	}())
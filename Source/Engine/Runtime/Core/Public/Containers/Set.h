@@ -0,0 +1,668 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Memory/Memory.h"
+#include "TypeHash.h"
+#include "TypeTraits.h"
+
+#include <initializer_list>
+#include <new>
+
+#if !defined(HASH_TABLE_GROUP_SSE2)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define HASH_TABLE_GROUP_SSE2 1
+	#else
+		#define HASH_TABLE_GROUP_SSE2 0
+	#endif
+#endif
+
+#if !defined(HASH_TABLE_GROUP_NEON)
+	#if !HASH_TABLE_GROUP_SSE2 && (defined(__ARM_NEON) || defined(_M_ARM64))
+		#define HASH_TABLE_GROUP_NEON 1
+	#else
+		#define HASH_TABLE_GROUP_NEON 0
+	#endif
+#endif
+
+#if HASH_TABLE_GROUP_SSE2
+	#include <emmintrin.h>
+#elif HASH_TABLE_GROUP_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace Private
+{
+	// Every slot of a hash table has a control byte: the low 7 bits of the element hash when the slot is
+	// full, or one of the negative values below. The control bytes of a probe group are compared at once.
+	enum EHashControl : i8
+	{
+		HashControl_Empty = -128,
+		HashControl_Deleted = -2
+	};
+
+	/** Set of matching slots of a group, one bit (or one byte for the 8 wide groups) per slot. */
+	template<u32 Shift>
+	struct THashGroupMask
+	{
+		u64 Mask;
+
+		FORCEINLINE explicit operator bool() const { return Mask != 0; }
+		FORCEINLINE u32 Lowest() const { return FMath::CountTrailingZeros64(Mask) >> Shift; }
+		FORCEINLINE void ClearLowest() { Mask &= Mask - 1; }
+	};
+
+#if HASH_TABLE_GROUP_SSE2
+
+	struct FHashGroup
+	{
+		CONSTEXPR static u32 Width = 16;
+		typedef THashGroupMask<0> FMask;
+
+		FORCEINLINE explicit FHashGroup(const i8* control)
+			: m_Control(_mm_loadu_si128((const __m128i*)control))
+		{
+		}
+
+		FORCEINLINE FMask Match(i8 hash) const
+		{
+			return FMask{ (u64)(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), m_Control)) };
+		}
+
+		FORCEINLINE FMask MatchEmpty() const
+		{
+			return Match(HashControl_Empty);
+		}
+
+		FORCEINLINE FMask MatchEmptyOrDeleted() const
+		{
+			return FMask{ (u64)(u32)_mm_movemask_epi8(m_Control) };
+		}
+
+		__m128i m_Control;
+	};
+
+#elif HASH_TABLE_GROUP_NEON
+
+	struct FHashGroup
+	{
+		CONSTEXPR static u32 Width = 8;
+		typedef THashGroupMask<3> FMask;
+
+		FORCEINLINE explicit FHashGroup(const i8* control)
+			: m_Control(vld1_s8(control))
+		{
+		}
+
+		FORCEINLINE FMask Match(i8 hash) const
+		{
+			return ToMask(vceq_s8(vdup_n_s8(hash), m_Control));
+		}
+
+		FORCEINLINE FMask MatchEmpty() const
+		{
+			return Match(HashControl_Empty);
+		}
+
+		FORCEINLINE FMask MatchEmptyOrDeleted() const
+		{
+			return ToMask(vcltz_s8(m_Control));
+		}
+
+		FORCEINLINE static FMask ToMask(uint8x8_t matches)
+		{
+			return FMask{ vget_lane_u64(vreinterpret_u64_u8(matches), 0) & 0x8080808080808080ull };
+		}
+
+		int8x8_t m_Control;
+	};
+
+#else
+
+	// Portable fallback working on 8 control bytes in a u64. Match can report false positives, which
+	// the key comparison filters out; the empty and deleted masks are exact.
+	struct FHashGroup
+	{
+		CONSTEXPR static u32 Width = 8;
+		typedef THashGroupMask<3> FMask;
+
+		CONSTEXPR static u64 LowBits = 0x0101010101010101ull;
+		CONSTEXPR static u64 HighBits = 0x8080808080808080ull;
+
+		FORCEINLINE explicit FHashGroup(const i8* control)
+		{
+			memcpy(&m_Control, control, sizeof(m_Control));
+		}
+
+		FORCEINLINE FMask Match(i8 hash) const
+		{
+			const u64 bytes = m_Control ^ (LowBits * (u8)hash);
+			return FMask{ (bytes - LowBits) & ~bytes & HighBits };
+		}
+
+		FORCEINLINE FMask MatchEmpty() const
+		{
+			return FMask{ m_Control & (~m_Control << 6) & HighBits };
+		}
+
+		FORCEINLINE FMask MatchEmptyOrDeleted() const
+		{
+			return FMask{ m_Control & HighBits };
+		}
+
+		u64 m_Control;
+	};
+
+#endif
+}
+
+/** Key functions of a set whose elements are their own keys. */
+template<typename ElementType>
+struct DefaultKeyFuncs
+{
+	typedef ElementType KeyType;
+
+	FORCEINLINE static const KeyType& GetKey(const ElementType& element)
+	{
+		return element;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE static bool Matches(const KeyType& key, const ComparableKey& other)
+	{
+		return key == other;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE static u64 GetKeyHash(const ComparableKey& key)
+	{
+		return GetTypeHash(key);
+	}
+};
+
+/**
+ * Unordered set stored in one flat array with open addressing. Slots are probed a group at a time: the
+ * control bytes of a group are matched against 7 bits of the hash with SSE2 or NEON, and only the slots that
+ * match compare their keys. Deleted slots are left as tombstones until the next rehash.
+ *
+ * Lookups take any key that KeyFuncs can hash and compare, so a set of FString can be searched with an
+ * FStringView, and FindByHash skips hashing entirely when the caller already has the hash.
+ * Element addresses are stable until the set grows or is rehashed.
+ */
+template<typename ElementType, typename KeyFuncs = DefaultKeyFuncs<ElementType>, typename Allocator = FHeapAllocator>
+class TSet
+{
+public:
+
+	typedef typename KeyFuncs::KeyType KeyType;
+	typedef Allocator AllocatorType;
+
+	template<bool bConst>
+	class TIterator
+	{
+	public:
+
+		typedef typename TConditional<bConst, const TSet, TSet>::Type SetType;
+		typedef typename TConditional<bConst, const ElementType, ElementType>::Type ItemType;
+
+	public:
+
+		FORCEINLINE TIterator(SetType& set, u32 index) : m_Set(set), m_Index(index)
+		{
+			SkipToFull();
+		}
+
+		FORCEINLINE ItemType& operator*() const { return m_Set.m_Elements[m_Index]; }
+		FORCEINLINE ItemType* operator->() const { return &m_Set.m_Elements[m_Index]; }
+
+		FORCEINLINE TIterator& operator++()
+		{
+			++m_Index;
+			SkipToFull();
+			return *this;
+		}
+
+		FORCEINLINE bool operator!=(const TIterator& other) const { return m_Index != other.m_Index; }
+		FORCEINLINE bool operator==(const TIterator& other) const { return m_Index == other.m_Index; }
+
+	private:
+
+		FORCEINLINE void SkipToFull()
+		{
+			while (m_Index < m_Set.m_Capacity && m_Set.m_Control[m_Index] < 0)
+			{
+				++m_Index;
+			}
+		}
+
+	private:
+
+		SetType& m_Set;
+		u32 m_Index;
+	};
+
+	typedef TIterator<false> FIterator;
+	typedef TIterator<true> FConstIterator;
+
+public:
+
+	FORCEINLINE TSet() : m_Control(nullptr), m_Elements(nullptr), m_Capacity(0), m_Num(0), m_NumDeleted(0) { }
+
+	FORCEINLINE TSet(std::initializer_list<ElementType> list) : TSet()
+	{
+		Reserve((i32)list.size());
+		for (const ElementType& element : list)
+		{
+			Add(element);
+		}
+	}
+
+	FORCEINLINE TSet(const TSet& other) : TSet()
+	{
+		CopyFrom(other);
+	}
+
+	FORCEINLINE TSet(TSet&& other)
+		: m_Control(other.m_Control), m_Elements(other.m_Elements), m_Capacity(other.m_Capacity), m_Num(other.m_Num), m_NumDeleted(other.m_NumDeleted)
+	{
+		other.m_Control = nullptr;
+		other.m_Elements = nullptr;
+		other.m_Capacity = 0;
+		other.m_Num = 0;
+		other.m_NumDeleted = 0;
+	}
+
+	FORCEINLINE ~TSet()
+	{
+		DestructElements();
+		m_Allocator.Free(m_Control);
+	}
+
+public:
+
+	FORCEINLINE TSet& operator=(const TSet& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			CopyFrom(other);
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE TSet& operator=(TSet&& other)
+	{
+		if (this != &other)
+		{
+			this->~TSet();
+			new (this) TSet(MoveTemp(other));
+		}
+
+		return *this;
+	}
+
+public:
+
+	FORCEINLINE i32 Num() const { return (i32)m_Num; }
+	FORCEINLINE i32 Max() const { return (i32)GetMaxLoad(m_Capacity); }
+	FORCEINLINE bool IsEmpty() const { return m_Num == 0; }
+
+	FORCEINLINE FIterator begin() { return FIterator(*this, 0); }
+	FORCEINLINE FIterator end() { return FIterator(*this, m_Capacity); }
+	FORCEINLINE FConstIterator begin() const { return FConstIterator(*this, 0); }
+	FORCEINLINE FConstIterator end() const { return FConstIterator(*this, m_Capacity); }
+
+public:
+
+	/** Adds the element unless one with the same key is already in the set, in which case that one is replaced. */
+	FORCEINLINE ElementType& Add(const ElementType& element, bool* bOutAlreadyInSet = nullptr)
+	{
+		return Emplace(element, bOutAlreadyInSet);
+	}
+
+	FORCEINLINE ElementType& Add(ElementType&& element, bool* bOutAlreadyInSet = nullptr)
+	{
+		return Emplace(MoveTemp(element), bOutAlreadyInSet);
+	}
+
+	template<typename ArgType>
+	FORCEINLINE ElementType& Emplace(ArgType&& arg, bool* bOutAlreadyInSet = nullptr)
+	{
+		ElementType element(Forward<ArgType>(arg));
+
+		const KeyType& key = KeyFuncs::GetKey(element);
+		const u64 hash = KeyFuncs::GetKeyHash(key);
+
+		const u32 index = FindIndex(key, hash);
+		if (bOutAlreadyInSet != nullptr)
+		{
+			*bOutAlreadyInSet = index != InvalidIndex;
+		}
+
+		if (index != InvalidIndex)
+		{
+			m_Elements[index].~ElementType();
+			return *new (m_Elements + index) ElementType(MoveTemp(element));
+		}
+
+		// InsertNew may move the elements, so the address is taken after it.
+		const u32 newIndex = InsertNew(hash);
+		return *new (m_Elements + newIndex) ElementType(MoveTemp(element));
+	}
+
+	/** Returns the element with the given key, adding one constructed from createArgs if there is none. */
+	template<typename ComparableKey, typename... ArgTypes>
+	FORCEINLINE ElementType& FindOrAddByHash(u64 hash, const ComparableKey& key, ArgTypes&&... createArgs)
+	{
+		const u32 index = FindIndex(key, hash);
+		if (index != InvalidIndex)
+		{
+			return m_Elements[index];
+		}
+
+		const u32 newIndex = InsertNew(hash);
+		return *new (m_Elements + newIndex) ElementType(Forward<ArgTypes>(createArgs)...);
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE ElementType* Find(const ComparableKey& key)
+	{
+		return FindByHash(KeyFuncs::GetKeyHash(key), key);
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ElementType* Find(const ComparableKey& key) const
+	{
+		return FindByHash(KeyFuncs::GetKeyHash(key), key);
+	}
+
+	/** Finds by a hash computed earlier with KeyFuncs::GetKeyHash. */
+	template<typename ComparableKey>
+	FORCEINLINE ElementType* FindByHash(u64 hash, const ComparableKey& key)
+	{
+		const u32 index = FindIndex(key, hash);
+		return index != InvalidIndex ? m_Elements + index : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ElementType* FindByHash(u64 hash, const ComparableKey& key) const
+	{
+		const u32 index = FindIndex(key, hash);
+		return index != InvalidIndex ? m_Elements + index : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE bool Contains(const ComparableKey& key) const
+	{
+		return Find(key) != nullptr;
+	}
+
+	/** Removes the element with the given key. Returns the number of elements removed. */
+	template<typename ComparableKey>
+	FORCEINLINE i32 Remove(const ComparableKey& key)
+	{
+		return RemoveByHash(KeyFuncs::GetKeyHash(key), key);
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE i32 RemoveByHash(u64 hash, const ComparableKey& key)
+	{
+		const u32 index = FindIndex(key, hash);
+		if (index == InvalidIndex)
+		{
+			return 0;
+		}
+
+		m_Elements[index].~ElementType();
+		SetControl(index, Private::HashControl_Deleted);
+
+		--m_Num;
+		++m_NumDeleted;
+		return 1;
+	}
+
+public:
+
+	/** Makes room for count elements without growing again. */
+	FORCEINLINE void Reserve(i32 count)
+	{
+		if ((u32)count > GetMaxLoad(m_Capacity))
+		{
+			Rehash(GetCapacityFor((u32)count));
+		}
+	}
+
+	/** Removes all elements but keeps the storage. */
+	FORCEINLINE void Reset()
+	{
+		DestructElements();
+		if (m_Control != nullptr)
+		{
+			memset(m_Control, Private::HashControl_Empty, m_Capacity + Group::Width);
+		}
+
+		m_Num = 0;
+		m_NumDeleted = 0;
+	}
+
+	/** Removes all elements and resizes the storage to hold slack elements. */
+	FORCEINLINE void Empty(i32 slack = 0)
+	{
+		DestructElements();
+		m_Allocator.Free(m_Control);
+
+		m_Control = nullptr;
+		m_Elements = nullptr;
+		m_Capacity = 0;
+		m_Num = 0;
+		m_NumDeleted = 0;
+
+		if (slack > 0)
+		{
+			Reserve(slack);
+		}
+	}
+
+	/** Rehashes to the smallest capacity holding the elements, dropping the tombstones. */
+	FORCEINLINE void Shrink()
+	{
+		const u32 capacity = m_Num > 0 ? GetCapacityFor(m_Num) : 0;
+		if (capacity != m_Capacity || m_NumDeleted > 0)
+		{
+			Rehash(capacity);
+		}
+	}
+
+private:
+
+	typedef Private::FHashGroup Group;
+
+	CONSTEXPR static u32 InvalidIndex = 0xFFFFFFFF;
+
+	FORCEINLINE static u32 GetMaxLoad(u32 capacity)
+	{
+		return capacity - capacity / 8;
+	}
+
+	FORCEINLINE static u32 GetCapacityFor(u32 count)
+	{
+		u32 capacity = Group::Width;
+		while (GetMaxLoad(capacity) < count)
+		{
+			capacity *= 2;
+		}
+
+		return capacity;
+	}
+
+	FORCEINLINE static i8 GetControlHash(u64 hash) { return (i8)(hash & 0x7F); }
+	FORCEINLINE static u64 GetProbeHash(u64 hash) { return hash >> 7; }
+
+	// The first Group::Width control bytes are mirrored after the last slot, so a group loaded near the
+	// end of the table wraps around without a branch.
+	FORCEINLINE void SetControl(u32 index, i8 value)
+	{
+		m_Control[index] = value;
+		if (index < Group::Width)
+		{
+			m_Control[m_Capacity + index] = value;
+		}
+	}
+
+	template<typename ComparableKey>
+	u32 FindIndex(const ComparableKey& key, u64 hash) const
+	{
+		if (m_Capacity == 0)
+		{
+			return InvalidIndex;
+		}
+
+		const u32 mask = m_Capacity - 1;
+		const i8 controlHash = GetControlHash(hash);
+
+		// Triangular steps over groups visit every group once when the capacity is a power of two.
+		u32 position = (u32)GetProbeHash(hash) & mask;
+		for (u32 step = Group::Width; ; step += Group::Width)
+		{
+			const Group group(m_Control + position);
+
+			for (typename Group::FMask matches = group.Match(controlHash); matches; matches.ClearLowest())
+			{
+				const u32 index = (position + matches.Lowest()) & mask;
+				if (KeyFuncs::Matches(KeyFuncs::GetKey(m_Elements[index]), key))
+				{
+					return index;
+				}
+			}
+
+			if (group.MatchEmpty() || step > m_Capacity)
+			{
+				return InvalidIndex;
+			}
+
+			position = (position + step) & mask;
+		}
+	}
+
+	FORCEINLINE u32 FindInsertIndex(u64 hash) const
+	{
+		const u32 mask = m_Capacity - 1;
+
+		u32 position = (u32)GetProbeHash(hash) & mask;
+		for (u32 step = Group::Width; ; step += Group::Width)
+		{
+			const typename Group::FMask free = Group(m_Control + position).MatchEmptyOrDeleted();
+			if (free)
+			{
+				return (position + free.Lowest()) & mask;
+			}
+
+			position = (position + step) & mask;
+		}
+	}
+
+	/** Claims a slot for a key known not to be in the set and returns its index, growing first if needed. */
+	u32 InsertNew(u64 hash)
+	{
+		if (m_Num + m_NumDeleted + 1 > GetMaxLoad(m_Capacity))
+		{
+			// Mostly tombstones: rehashing at the same capacity is enough to make room.
+			const bool bSameCapacity = m_Capacity > 0 && m_Num + 1 <= GetMaxLoad(m_Capacity) / 2;
+			Rehash(bSameCapacity ? m_Capacity : GetCapacityFor(m_Num + 1 > m_Capacity ? m_Num + 1 : m_Capacity));
+		}
+
+		const u32 index = FindInsertIndex(hash);
+		if (m_Control[index] == Private::HashControl_Deleted)
+		{
+			--m_NumDeleted;
+		}
+
+		SetControl(index, GetControlHash(hash));
+		++m_Num;
+		return index;
+	}
+
+	void Rehash(u32 capacity)
+	{
+		i8* oldControl = m_Control;
+		ElementType* oldElements = m_Elements;
+		const u32 oldCapacity = m_Capacity;
+
+		if (capacity == 0)
+		{
+			m_Control = nullptr;
+			m_Elements = nullptr;
+		}
+		else
+		{
+			const SIZE_T elementsOffset = FMalloc::Align((SIZE_T)capacity + Group::Width, alignof(ElementType));
+			const u64 alignment = alignof(ElementType) > MIN_ALIGNMENT ? alignof(ElementType) : DEFAULT_ALIGNMENT;
+
+			m_Control = (i8*)m_Allocator.Allocate(elementsOffset + (SIZE_T)capacity * sizeof(ElementType), alignment);
+			CHECK(m_Control != nullptr);
+
+			m_Elements = (ElementType*)((u8*)m_Control + elementsOffset);
+			memset(m_Control, Private::HashControl_Empty, capacity + Group::Width);
+		}
+
+		m_Capacity = capacity;
+		m_NumDeleted = 0;
+
+		for (u32 i = 0; i < oldCapacity; ++i)
+		{
+			if (oldControl[i] < 0)
+			{
+				continue;
+			}
+
+			ElementType& element = oldElements[i];
+			const u64 hash = KeyFuncs::GetKeyHash(KeyFuncs::GetKey(element));
+
+			const u32 index = FindInsertIndex(hash);
+			SetControl(index, GetControlHash(hash));
+
+			new (m_Elements + index) ElementType(MoveTemp(element));
+			element.~ElementType();
+		}
+
+		m_Allocator.Free(oldControl);
+	}
+
+	FORCEINLINE void DestructElements()
+	{
+		if (TIsTriviallyDestructible<ElementType>::Value)
+		{
+			return;
+		}
+
+		for (u32 i = 0; i < m_Capacity; ++i)
+		{
+			if (m_Control[i] >= 0)
+			{
+				m_Elements[i].~ElementType();
+			}
+		}
+	}
+
+	FORCEINLINE void CopyFrom(const TSet& other)
+	{
+		Reserve(other.Num());
+		for (const ElementType& element : other)
+		{
+			const u64 hash = KeyFuncs::GetKeyHash(KeyFuncs::GetKey(element));
+			const u32 index = InsertNew(hash);
+			new (m_Elements + index) ElementType(element);
+		}
+	}
+
+private:
+
+	i8* m_Control;
+	ElementType* m_Elements;
+	u32 m_Capacity;
+	u32 m_Num;
+	u32 m_NumDeleted;
+
+	Allocator m_Allocator;
+};
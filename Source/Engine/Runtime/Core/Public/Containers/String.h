@@ -1,69 +1,901 @@
 #pragma once
 
 #include "HAL/Platform.h"
+#include "Memory/Memory.h"
+#include "Memory/PoolAllocator.h"
+#include "Containers/StringView.h"
 #include "TypeTraits.h"
 
 #include <atomic>	
+#include <new>
+
+namespace Private
+{
+	/**
+	 * Strong and weak reference counts of a shared object. The object is destroyed when the strong count
+	 * reaches zero and the block itself when the weak count does; all strong references together hold one weak reference.
+	 * In the thread safe mode increments are relaxed, since a new reference can only be made from an existing one,
+	 * and decrements release so every write through a reference happens before the destruction, which acquires.
+	 */
+	template<bool ThreadSafe>
+	class TSharedControlBlock
+	{
+	public:
+
+		using RefCountType = typename TConditional<ThreadSafe, std::atomic<i32>, i32>::Type;
+
+	public:
+
+		FORCEINLINE TSharedControlBlock() : m_StrongCount(1), m_WeakCount(1) { }
+		virtual ~TSharedControlBlock() = default;
+
+		virtual void DestroyObject() = 0;
+		virtual void FreeBlock() = 0;
+
+	public:
+
+		FORCEINLINE void AddStrongRef()
+		{
+			if constexpr (ThreadSafe)
+			{
+				m_StrongCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				++m_StrongCount;
+			}
+		}
+
+		/** Adds a strong reference unless the object is already destroyed. */
+		FORCEINLINE bool TryAddStrongRef()
+		{
+			if constexpr (ThreadSafe)
+			{
+				i32 count = m_StrongCount.load(std::memory_order_relaxed);
+				while (count != 0)
+				{
+					if (m_StrongCount.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+			else
+			{
+				if (m_StrongCount == 0)
+				{
+					return false;
+				}
+
+				++m_StrongCount;
+				return true;
+			}
+		}
+
+		FORCEINLINE void ReleaseStrongRef()
+		{
+			if constexpr (ThreadSafe)
+			{
+				if (m_StrongCount.fetch_sub(1, std::memory_order_release) != 1)
+				{
+					return;
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			else
+			{
+				if (--m_StrongCount != 0)
+				{
+					return;
+				}
+			}
+
+			DestroyObject();
+			ReleaseWeakRef();
+		}
+
+		FORCEINLINE void AddWeakRef()
+		{
+			if constexpr (ThreadSafe)
+			{
+				m_WeakCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				++m_WeakCount;
+			}
+		}
+
+		FORCEINLINE void ReleaseWeakRef()
+		{
+			if constexpr (ThreadSafe)
+			{
+				if (m_WeakCount.fetch_sub(1, std::memory_order_release) != 1)
+				{
+					return;
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			else
+			{
+				if (--m_WeakCount != 0)
+				{
+					return;
+				}
+			}
+
+			FreeBlock();
+		}
+
+		FORCEINLINE i32 GetStrongRefCount() const
+		{
+			if constexpr (ThreadSafe)
+			{
+				return m_StrongCount.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				return m_StrongCount;
+			}
+		}
+
+	private:
+
+		RefCountType m_StrongCount;
+		RefCountType m_WeakCount;
+	};
+
+	/** Control block allocated together with the object it counts, created by MakeShared. */
+	template<typename T, bool ThreadSafe>
+	class TInlineSharedControlBlock : public TSharedControlBlock<ThreadSafe>
+	{
+	public:
+
+		template<typename... ArgTypes>
+		FORCEINLINE explicit TInlineSharedControlBlock(ArgTypes&&... args)
+		{
+			new (m_Storage) T(Forward<ArgTypes>(args)...);
+		}
+
+		FORCEINLINE T* GetObject()
+		{
+			return (T*)m_Storage;
+		}
+
+		virtual void DestroyObject() override
+		{
+			GetObject()->~T();
+		}
+
+		virtual void FreeBlock() override
+		{
+			this->~TInlineSharedControlBlock();
+			GMalloc->Free(this);
+		}
+
+	private:
+
+		alignas(T) u8 m_Storage[sizeof(T)];
+	};
+
+	/** Control block for an object allocated with new and adopted by a TSharedPtr. Doesn't depend on T so all of them share one pool. */
+	template<bool ThreadSafe>
+	class TAdoptedSharedControlBlock : public TSharedControlBlock<ThreadSafe>
+	{
+	public:
+
+		using PoolType = TPoolAllocator<TAdoptedSharedControlBlock, true>;
+
+	public:
+
+		FORCEINLINE TAdoptedSharedControlBlock(void* object, void (*deleter)(void*)) : m_Object(object), m_Deleter(deleter) { }
+
+		template<typename T>
+		FORCEINLINE static TAdoptedSharedControlBlock* Create(T* object)
+		{
+			void (*deleter)(void*) = [](void* ptr) { delete (T*)ptr; };
+
+			PoolType& pool = GetPool();
+			void* memory = pool.Allocate();
+			if (memory == nullptr)
+			{
+				memory = GMalloc->Malloc(sizeof(TAdoptedSharedControlBlock), alignof(TAdoptedSharedControlBlock));
+			}
+
+			return new (memory) TAdoptedSharedControlBlock(object, deleter);
+		}
+
+		virtual void DestroyObject() override
+		{
+			m_Deleter(m_Object);
+		}
+
+		virtual void FreeBlock() override
+		{
+			PoolType& pool = GetPool();
+			this->~TAdoptedSharedControlBlock();
+
+			if (pool.Owns(this))
+			{
+				pool.Free(this);
+			}
+			else
+			{
+				GMalloc->Free(this);
+			}
+		}
+
+	private:
+
+		// The pool is never destroyed so shared pointers held by other statics can still be released at exit.
+		FORCEINLINE static PoolType& GetPool()
+		{
+			alignas(PoolType) static u8 storage[sizeof(PoolType)];
+			static PoolType* pool = new (storage) PoolType();
+			return *pool;
+		}
+
+	private:
+
+		void* m_Object;
+		void (*m_Deleter)(void*);
+	};
+}
 
 template<typename T, bool ThreadSafe = false>
 struct TSharedPtr
 {
 private:
 
-	using RefCountType = typename TConditional<ThreadSafe, std::atomic<i32>, i32>::Type;
+	using ControlBlockType = Private::TSharedControlBlock<ThreadSafe>;
 
-public:
-
-	FORCEINLINE TSharedPtr() : m_RefCount(nullptr), m_Ptr(nullptr) { }
+	template<typename U, bool OtherThreadSafe> friend struct TSharedPtr;
+	template<typename U, bool OtherThreadSafe> friend struct TWeakPtr;
+	template<typename U, bool OtherThreadSafe, typename... ArgTypes> friend TSharedPtr<U, OtherThreadSafe> MakeShared(ArgTypes&&... args);
 
 public:
 
-	FORCEINLINE TSharedPtr(const TSharedPtr& other) : m_RefCount(other.m_RefCount), m_Ptr(other.m_Ptr)
+	FORCEINLINE TSharedPtr() : m_ControlBlock(nullptr), m_Ptr(nullptr) { }
+	FORCEINLINE TSharedPtr(TYPE_OF_NULLPTR) : m_ControlBlock(nullptr), m_Ptr(nullptr) { }
+
+	/** Takes ownership of an object allocated with new. Prefer MakeShared, which needs a single allocation. */
+	FORCEINLINE explicit TSharedPtr(T* ptr) : m_ControlBlock(nullptr), m_Ptr(ptr)
 	{
-		if (!m_RefCount)
+		if (ptr != nullptr)
 		{
-			return;
+			m_ControlBlock = Private::TAdoptedSharedControlBlock<ThreadSafe>::Create(ptr);
 		}
+	}
+
+public:
 
-		++(*m_RefCount);
+	FORCEINLINE TSharedPtr(const TSharedPtr& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		AddRef();
 	}
 
-	FORCEINLINE TSharedPtr(TSharedPtr&& other) : m_RefCount(other.m_RefCount), m_Ptr(other.m_Ptr)
+	FORCEINLINE TSharedPtr(TSharedPtr&& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
 	{
-		other.m_RefCount = nullptr;
+		other.m_ControlBlock = nullptr;
+		other.m_Ptr = nullptr;
+	}
+
+	template<typename U>
+	FORCEINLINE TSharedPtr(const TSharedPtr<U, ThreadSafe>& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		AddRef();
+	}
+
+	template<typename U>
+	FORCEINLINE TSharedPtr(TSharedPtr<U, ThreadSafe>&& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		other.m_ControlBlock = nullptr;
 		other.m_Ptr = nullptr;
 	}
 
 	FORCEINLINE ~TSharedPtr()
 	{
-		if (!m_RefCount)
+		Release();
+	}
+
+public:
+
+	FORCEINLINE TSharedPtr& operator=(const TSharedPtr& other)
+	{
+		// Take the new reference first so self assignment never drops the count to zero.
+		TSharedPtr copy(other);
+		Swap(copy);
+		return *this;
+	}
+
+	FORCEINLINE TSharedPtr& operator=(TSharedPtr&& other)
+	{
+		if (this != &other)
+		{
+			Release();
+
+			m_ControlBlock = other.m_ControlBlock;
+			m_Ptr = other.m_Ptr;
+
+			other.m_ControlBlock = nullptr;
+			other.m_Ptr = nullptr;
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE TSharedPtr& operator=(TYPE_OF_NULLPTR)
+	{
+		Reset();
+		return *this;
+	}
+
+	FORCEINLINE T* operator->() const
+	{
+		CHECK(m_Ptr != nullptr);
+		return m_Ptr;
+	}
+
+	FORCEINLINE T& operator*() const
+	{
+		CHECK(m_Ptr != nullptr);
+		return *m_Ptr;
+	}
+
+	FORCEINLINE explicit operator bool() const
+	{
+		return m_Ptr != nullptr;
+	}
+
+	FORCEINLINE bool operator==(const TSharedPtr& other) const
+	{
+		return m_Ptr == other.m_Ptr;
+	}
+
+	FORCEINLINE bool operator!=(const TSharedPtr& other) const
+	{
+		return m_Ptr != other.m_Ptr;
+	}
+
+public:
+
+	FORCEINLINE T* Get() const
+	{
+		return m_Ptr;
+	}
+
+	FORCEINLINE bool IsValid() const
+	{
+		return m_Ptr != nullptr;
+	}
+
+	FORCEINLINE void Reset()
+	{
+		Release();
+		m_ControlBlock = nullptr;
+		m_Ptr = nullptr;
+	}
+
+	FORCEINLINE void Swap(TSharedPtr& other)
+	{
+		ControlBlockType* controlBlock = m_ControlBlock;
+		T* ptr = m_Ptr;
+
+		m_ControlBlock = other.m_ControlBlock;
+		m_Ptr = other.m_Ptr;
+
+		other.m_ControlBlock = controlBlock;
+		other.m_Ptr = ptr;
+	}
+
+	FORCEINLINE i32 GetRefCount() const
+	{
+		return m_ControlBlock ? m_ControlBlock->GetStrongRefCount() : 0;
+	}
+
+private:
+
+	FORCEINLINE TSharedPtr(ControlBlockType* controlBlock, T* ptr) : m_ControlBlock(controlBlock), m_Ptr(ptr) { }
+
+	FORCEINLINE void AddRef()
+	{
+		if (!m_ControlBlock)
 		{
 			return;
 		}
 
-		if (--(*m_RefCount) == 0)
+		m_ControlBlock->AddStrongRef();
+	}
+
+	FORCEINLINE void Release()
+	{
+		if (!m_ControlBlock)
 		{
-			// TODO: Use a custom allocator
-			delete m_RefCount;
-			delete m_Ptr;
+			return;
 		}
+
+		m_ControlBlock->ReleaseStrongRef();
 	}
 
+private:
+
+	ControlBlockType* m_ControlBlock;
+	T* m_Ptr;
+};
+
+/** Non owning reference to an object owned by TSharedPtr. Pin gives temporary ownership while the object is alive. */
+template<typename T, bool ThreadSafe = false>
+struct TWeakPtr
+{
+private:
+
+	using ControlBlockType = Private::TSharedControlBlock<ThreadSafe>;
+
+	template<typename U, bool OtherThreadSafe> friend struct TWeakPtr;
+
 public:
 
-	FORCEINLINE i32 GetRefCount() const
+	FORCEINLINE TWeakPtr() : m_ControlBlock(nullptr), m_Ptr(nullptr) { }
+	FORCEINLINE TWeakPtr(TYPE_OF_NULLPTR) : m_ControlBlock(nullptr), m_Ptr(nullptr) { }
+
+	template<typename U>
+	FORCEINLINE TWeakPtr(const TSharedPtr<U, ThreadSafe>& shared) : m_ControlBlock(shared.m_ControlBlock), m_Ptr(shared.m_Ptr)
 	{
-		return m_RefCount ? *m_RefCount : 0;
+		AddRef();
+	}
+
+	FORCEINLINE TWeakPtr(const TWeakPtr& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		AddRef();
+	}
+
+	FORCEINLINE TWeakPtr(TWeakPtr&& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		other.m_ControlBlock = nullptr;
+		other.m_Ptr = nullptr;
+	}
+
+	template<typename U>
+	FORCEINLINE TWeakPtr(const TWeakPtr<U, ThreadSafe>& other) : m_ControlBlock(other.m_ControlBlock), m_Ptr(other.m_Ptr)
+	{
+		AddRef();
+	}
+
+	FORCEINLINE ~TWeakPtr()
+	{
+		Release();
+	}
+
+public:
+
+	FORCEINLINE TWeakPtr& operator=(const TWeakPtr& other)
+	{
+		TWeakPtr copy(other);
+		Swap(copy);
+		return *this;
+	}
+
+	FORCEINLINE TWeakPtr& operator=(TWeakPtr&& other)
+	{
+		if (this != &other)
+		{
+			Release();
+
+			m_ControlBlock = other.m_ControlBlock;
+			m_Ptr = other.m_Ptr;
+
+			other.m_ControlBlock = nullptr;
+			other.m_Ptr = nullptr;
+		}
+
+		return *this;
+	}
+
+	template<typename U>
+	FORCEINLINE TWeakPtr& operator=(const TSharedPtr<U, ThreadSafe>& shared)
+	{
+		TWeakPtr copy(shared);
+		Swap(copy);
+		return *this;
+	}
+
+public:
+
+	/** Returns a shared pointer to the object, or an empty one if it was already destroyed. Lock free. */
+	FORCEINLINE TSharedPtr<T, ThreadSafe> Pin() const
+	{
+		if (m_ControlBlock == nullptr || !m_ControlBlock->TryAddStrongRef())
+		{
+			return TSharedPtr<T, ThreadSafe>();
+		}
+
+		return TSharedPtr<T, ThreadSafe>(m_ControlBlock, m_Ptr);
+	}
+
+	FORCEINLINE bool IsValid() const
+	{
+		return m_ControlBlock != nullptr && m_ControlBlock->GetStrongRefCount() > 0;
+	}
+
+	FORCEINLINE void Reset()
+	{
+		Release();
+		m_ControlBlock = nullptr;
+		m_Ptr = nullptr;
+	}
+
+	FORCEINLINE void Swap(TWeakPtr& other)
+	{
+		ControlBlockType* controlBlock = m_ControlBlock;
+		T* ptr = m_Ptr;
+
+		m_ControlBlock = other.m_ControlBlock;
+		m_Ptr = other.m_Ptr;
+
+		other.m_ControlBlock = controlBlock;
+		other.m_Ptr = ptr;
 	}
 
 private:
 
-	RefCountType* m_RefCount;
+	FORCEINLINE void AddRef()
+	{
+		if (!m_ControlBlock)
+		{
+			return;
+		}
+
+		m_ControlBlock->AddWeakRef();
+	}
+
+	FORCEINLINE void Release()
+	{
+		if (!m_ControlBlock)
+		{
+			return;
+		}
+
+		m_ControlBlock->ReleaseWeakRef();
+	}
+
+private:
+
+	ControlBlockType* m_ControlBlock;
 	T* m_Ptr;
 };
 
+template<typename T, bool ThreadSafe> struct TIsTriviallyRelocatable<TSharedPtr<T, ThreadSafe>> : FTrueType { };
+template<typename T, bool ThreadSafe> struct TIsTriviallyRelocatable<TWeakPtr<T, ThreadSafe>> : FTrueType { };
+
+/** Creates an object and its reference count in a single GMalloc allocation. */
+template<typename T, bool ThreadSafe = false, typename... ArgTypes>
+FORCEINLINE TSharedPtr<T, ThreadSafe> MakeShared(ArgTypes&&... args)
+{
+	using ControlBlockType = Private::TInlineSharedControlBlock<T, ThreadSafe>;
+
+	void* memory = GMalloc->Malloc(sizeof(ControlBlockType), alignof(ControlBlockType));
+	ControlBlockType* controlBlock = new (memory) ControlBlockType(Forward<ArgTypes>(args)...);
+	return TSharedPtr<T, ThreadSafe>(controlBlock, controlBlock->GetObject());
+}
+
+/**
+ * Null terminated, growable string of TCHAR. Strings up to InlineCapacity characters are stored inside the
+ * object itself, longer ones in a GMalloc allocation whose capacity doubles as the string grows.
+ */
 struct FString
 {
-	WCHAR* m_Data;
-	u32 m_Size;
-};
\ No newline at end of file
+public:
+
+	CONSTEXPR static i32 InlineBytes = 40;
+	CONSTEXPR static i32 InlineCapacity = InlineBytes / sizeof(TCHAR) - 1;
+
+public:
+
+	FORCEINLINE FString() : m_Size(0), m_Capacity(InlineCapacity)
+	{
+		m_InlineData[0] = 0;
+	}
+
+	FORCEINLINE FString(FStringView view) : FString()
+	{
+		Append(view);
+	}
+
+	FORCEINLINE FString(const TCHAR* str) : FString(FStringView(str)) { }
+	FORCEINLINE FString(const TCHAR* str, i32 size) : FString(FStringView(str, size)) { }
+
+	FORCEINLINE FString(const FString& other) : FString(other.View()) { }
+
+	FORCEINLINE FString(FString&& other) : m_Size(other.m_Size), m_Capacity(other.m_Capacity)
+	{
+		if (other.IsInline())
+		{
+			memcpy(m_InlineData, other.m_InlineData, (m_Size + 1) * sizeof(TCHAR));
+		}
+		else
+		{
+			m_HeapData = other.m_HeapData;
+		}
+
+		other.SetEmptyInline();
+	}
+
+	FORCEINLINE ~FString()
+	{
+		if (!IsInline())
+		{
+			GMalloc->Free(m_HeapData);
+		}
+	}
+
+public:
+
+	FORCEINLINE FString& operator=(FStringView view)
+	{
+		// The view may point into this string, so it is copied out before the buffer is overwritten.
+		if (view.GetData() >= GetData() && view.GetData() < GetData() + m_Capacity + 1)
+		{
+			FString copy(view);
+			return *this = MoveTemp(copy);
+		}
+
+		Reset();
+		return Append(view);
+	}
+
+	FORCEINLINE FString& operator=(const TCHAR* str)
+	{
+		return *this = FStringView(str);
+	}
+
+	FORCEINLINE FString& operator=(const FString& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			Append(other.View());
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE FString& operator=(FString&& other)
+	{
+		if (this != &other)
+		{
+			this->~FString();
+			new (this) FString(MoveTemp(other));
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE TCHAR& operator[](i32 index)
+	{
+		CHECK(index >= 0 && index < m_Size);
+		return GetData()[index];
+	}
+
+	FORCEINLINE const TCHAR& operator[](i32 index) const
+	{
+		CHECK(index >= 0 && index < m_Size);
+		return GetData()[index];
+	}
+
+	FORCEINLINE const TCHAR* operator*() const { return GetData(); }
+	FORCEINLINE operator FStringView() const { return View(); }
+
+	FORCEINLINE FString& operator+=(FStringView view) { return Append(view); }
+	FORCEINLINE FString& operator+=(const TCHAR* str) { return Append(FStringView(str)); }
+	FORCEINLINE FString& operator+=(const FString& other) { return Append(other.View()); }
+	FORCEINLINE FString& operator+=(TCHAR c) { return Append(c); }
+
+	FORCEINLINE bool operator==(FStringView other) const { return View().Equals(other); }
+	FORCEINLINE bool operator!=(FStringView other) const { return !View().Equals(other); }
+	FORCEINLINE bool operator<(FStringView other) const { return View().Compare(other) < 0; }
+
+public:
+
+	FORCEINLINE i32 Len() const { return m_Size; }
+	FORCEINLINE i32 GetCapacity() const { return m_Capacity; }
+	FORCEINLINE bool IsEmpty() const { return m_Size == 0; }
+	FORCEINLINE bool IsInline() const { return m_Capacity == InlineCapacity; }
+
+	FORCEINLINE TCHAR* GetData() { return IsInline() ? m_InlineData : m_HeapData; }
+	FORCEINLINE const TCHAR* GetData() const { return IsInline() ? m_InlineData : m_HeapData; }
+
+	FORCEINLINE FStringView View() const { return FStringView(GetData(), m_Size); }
+
+	FORCEINLINE TCHAR* begin() { return GetData(); }
+	FORCEINLINE TCHAR* end() { return GetData() + m_Size; }
+	FORCEINLINE const TCHAR* begin() const { return GetData(); }
+	FORCEINLINE const TCHAR* end() const { return GetData() + m_Size; }
+
+public:
+
+	FORCEINLINE FString& Append(FStringView view)
+	{
+		const i32 size = view.Len();
+		if (size == 0)
+		{
+			return *this;
+		}
+
+		// Growing may free the buffer a view of this string points into.
+		if (m_Size + size > m_Capacity)
+		{
+			const TCHAR* data = GetData();
+			if (view.GetData() >= data && view.GetData() < data + m_Size)
+			{
+				const i32 offset = (i32)(view.GetData() - data);
+				Grow(m_Size + size);
+				view = FStringView(GetData() + offset, size);
+			}
+			else
+			{
+				Grow(m_Size + size);
+			}
+		}
+
+		TCHAR* data = GetData();
+		memmove(data + m_Size, view.GetData(), size * sizeof(TCHAR));
+		m_Size += size;
+		data[m_Size] = 0;
+		return *this;
+	}
+
+	FORCEINLINE FString& Append(TCHAR c)
+	{
+		if (m_Size + 1 > m_Capacity)
+		{
+			Grow(m_Size + 1);
+		}
+
+		TCHAR* data = GetData();
+		data[m_Size++] = c;
+		data[m_Size] = 0;
+		return *this;
+	}
+
+	FORCEINLINE void Reserve(i32 capacity)
+	{
+		if (capacity > m_Capacity)
+		{
+			ResizeTo(capacity);
+		}
+	}
+
+	/** Clears the string but keeps its storage. */
+	FORCEINLINE void Reset()
+	{
+		m_Size = 0;
+		GetData()[0] = 0;
+	}
+
+	/** Clears the string and releases its heap storage. */
+	FORCEINLINE void Empty()
+	{
+		if (!IsInline())
+		{
+			GMalloc->Free(m_HeapData);
+		}
+
+		SetEmptyInline();
+	}
+
+	/** Moves the characters back inline if they fit, otherwise shrinks the heap storage to the size. */
+	FORCEINLINE void Shrink()
+	{
+		if (!IsInline() && m_Size != m_Capacity)
+		{
+			ResizeTo(m_Size);
+		}
+	}
+
+public:
+
+	FORCEINLINE FStringView Left(i32 count) const { return View().Left(count); }
+	FORCEINLINE FStringView Right(i32 count) const { return View().Right(count); }
+	FORCEINLINE FStringView Mid(i32 index, i32 count = 0x7FFFFFFF) const { return View().Mid(index, count); }
+	FORCEINLINE FStringView LeftChop(i32 count) const { return View().LeftChop(count); }
+	FORCEINLINE FStringView RightChop(i32 count) const { return View().RightChop(count); }
+
+	FORCEINLINE i32 Find(FStringView str, i32 startIndex = 0) const { return View().Find(str, startIndex); }
+	FORCEINLINE i32 Find(TCHAR c, i32 startIndex = 0) const { return View().Find(c, startIndex); }
+	FORCEINLINE i32 FindLast(TCHAR c) const { return View().FindLast(c); }
+	FORCEINLINE bool Contains(FStringView str) const { return View().Contains(str); }
+	FORCEINLINE bool StartsWith(FStringView str) const { return View().StartsWith(str); }
+	FORCEINLINE bool EndsWith(FStringView str) const { return View().EndsWith(str); }
+
+private:
+
+	FORCEINLINE void SetEmptyInline()
+	{
+		m_Size = 0;
+		m_Capacity = InlineCapacity;
+		m_InlineData[0] = 0;
+	}
+
+	FORCEINLINE void Grow(i32 requiredCapacity)
+	{
+		const i32 doubledCapacity = m_Capacity * 2 + 1;
+		ResizeTo(requiredCapacity > doubledCapacity ? requiredCapacity : doubledCapacity);
+	}
+
+	void ResizeTo(i32 capacity)
+	{
+		CHECK(capacity >= m_Size);
+
+		if (capacity <= InlineCapacity)
+		{
+			if (!IsInline())
+			{
+				TCHAR* heapData = m_HeapData;
+				memcpy(m_InlineData, heapData, (m_Size + 1) * sizeof(TCHAR));
+				GMalloc->Free(heapData);
+				m_Capacity = InlineCapacity;
+			}
+
+			return;
+		}
+
+		const SIZE_T size = ((SIZE_T)capacity + 1) * sizeof(TCHAR);
+		TCHAR* newData;
+
+		if (IsInline())
+		{
+			newData = (TCHAR*)GMalloc->Malloc(size);
+			CHECK(newData != nullptr);
+			memcpy(newData, m_InlineData, (m_Size + 1) * sizeof(TCHAR));
+		}
+		else
+		{
+			newData = (TCHAR*)GMalloc->Realloc(m_HeapData, size);
+			CHECK(newData != nullptr);
+		}
+
+		m_HeapData = newData;
+		m_Capacity = capacity;
+	}
+
+private:
+
+	union
+	{
+		TCHAR* m_HeapData;
+		TCHAR m_InlineData[InlineCapacity + 1];
+	};
+
+	i32 m_Size;
+
+	// Number of characters that fit without reallocating, not counting the terminator. Equals InlineCapacity
+	// exactly when the characters are stored inline, heap allocations are always bigger.
+	i32 m_Capacity;
+};
+
+// The inline characters are stored by value, nothing points into the object itself.
+template<> struct TIsTriviallyRelocatable<FString> : FTrueType { };
+
+FORCEINLINE u64 GetTypeHash(const FString& str)
+{
+	return GetTypeHash(str.View());
+}
+
+FORCEINLINE FString operator+(const FString& lhs, FStringView rhs)
+{
+	FString result;
+	result.Reserve(lhs.Len() + rhs.Len());
+	result.Append(lhs.View());
+	result.Append(rhs);
+	return result;
+}
+
+FORCEINLINE FString operator+(FString&& lhs, FStringView rhs)
+{
+	lhs.Append(rhs);
+	return MoveTemp(lhs);
+}
\ No newline at end of file
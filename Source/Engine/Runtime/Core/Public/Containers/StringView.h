@@ -0,0 +1,157 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "TypeHash.h"
+
+#include <string.h>
+
+/** Non owning range of characters. Not necessarily null terminated, slicing never copies. */
+struct FStringView
+{
+public:
+
+	CONSTEXPR FStringView() : m_Data(nullptr), m_Size(0) { }
+	CONSTEXPR FStringView(const TCHAR* data, i32 size) : m_Data(data), m_Size(size) { }
+	CONSTEXPR FStringView(const TCHAR* str) : m_Data(str), m_Size(str ? Strlen(str) : 0) { }
+
+public:
+
+	FORCEINLINE CONSTEXPR const TCHAR& operator[](i32 index) const
+	{
+		CHECK(IsValidIndex(index));
+		return m_Data[index];
+	}
+
+	FORCEINLINE bool operator==(FStringView other) const { return Equals(other); }
+	FORCEINLINE bool operator!=(FStringView other) const { return !Equals(other); }
+	FORCEINLINE bool operator<(FStringView other) const { return Compare(other) < 0; }
+
+public:
+
+	FORCEINLINE CONSTEXPR i32 Len() const { return m_Size; }
+	FORCEINLINE CONSTEXPR bool IsEmpty() const { return m_Size == 0; }
+	FORCEINLINE CONSTEXPR bool IsValidIndex(i32 index) const { return index >= 0 && index < m_Size; }
+	FORCEINLINE CONSTEXPR const TCHAR* GetData() const { return m_Data; }
+
+	FORCEINLINE CONSTEXPR const TCHAR* begin() const { return m_Data; }
+	FORCEINLINE CONSTEXPR const TCHAR* end() const { return m_Data + m_Size; }
+
+public:
+
+	FORCEINLINE CONSTEXPR FStringView Left(i32 count) const
+	{
+		return FStringView(m_Data, Clamp(count));
+	}
+
+	FORCEINLINE CONSTEXPR FStringView Right(i32 count) const
+	{
+		const i32 size = Clamp(count);
+		return FStringView(m_Data + m_Size - size, size);
+	}
+
+	/** Returns up to count characters starting at index. Out of range parts are cut off. */
+	FORCEINLINE CONSTEXPR FStringView Mid(i32 index, i32 count = 0x7FFFFFFF) const
+	{
+		const i32 start = Clamp(index);
+		const i32 size = count < m_Size - start ? (count < 0 ? 0 : count) : m_Size - start;
+		return FStringView(m_Data + start, size);
+	}
+
+	FORCEINLINE CONSTEXPR FStringView LeftChop(i32 count) const { return Left(m_Size - Clamp(count)); }
+	FORCEINLINE CONSTEXPR FStringView RightChop(i32 count) const { return Right(m_Size - Clamp(count)); }
+
+public:
+
+	FORCEINLINE i32 Compare(FStringView other) const
+	{
+		const i32 size = m_Size < other.m_Size ? m_Size : other.m_Size;
+		for (i32 i = 0; i < size; ++i)
+		{
+			if (m_Data[i] != other.m_Data[i])
+			{
+				return m_Data[i] < other.m_Data[i] ? -1 : 1;
+			}
+		}
+
+		return m_Size == other.m_Size ? 0 : (m_Size < other.m_Size ? -1 : 1);
+	}
+
+	FORCEINLINE bool Equals(FStringView other) const
+	{
+		return m_Size == other.m_Size && (m_Size == 0 || memcmp(m_Data, other.m_Data, m_Size * sizeof(TCHAR)) == 0);
+	}
+
+	/** Returns the index of the first occurrence of str at or after startIndex, or -1. */
+	FORCEINLINE i32 Find(FStringView str, i32 startIndex = 0) const
+	{
+		for (i32 i = Clamp(startIndex); i + str.m_Size <= m_Size; ++i)
+		{
+			if (Mid(i, str.m_Size).Equals(str))
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCEINLINE i32 Find(TCHAR c, i32 startIndex = 0) const
+	{
+		for (i32 i = Clamp(startIndex); i < m_Size; ++i)
+		{
+			if (m_Data[i] == c)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCEINLINE i32 FindLast(TCHAR c) const
+	{
+		for (i32 i = m_Size - 1; i >= 0; --i)
+		{
+			if (m_Data[i] == c)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	FORCEINLINE bool Contains(FStringView str) const { return Find(str) != -1; }
+	FORCEINLINE bool StartsWith(FStringView str) const { return str.m_Size <= m_Size && Left(str.m_Size).Equals(str); }
+	FORCEINLINE bool EndsWith(FStringView str) const { return str.m_Size <= m_Size && Right(str.m_Size).Equals(str); }
+
+public:
+
+	FORCEINLINE static CONSTEXPR i32 Strlen(const TCHAR* str)
+	{
+		i32 size = 0;
+		while (str[size] != 0)
+		{
+			++size;
+		}
+
+		return size;
+	}
+
+private:
+
+	FORCEINLINE CONSTEXPR i32 Clamp(i32 count) const
+	{
+		return count < 0 ? 0 : (count > m_Size ? m_Size : count);
+	}
+
+private:
+
+	const TCHAR* m_Data;
+	i32 m_Size;
+};
+
+FORCEINLINE u64 GetTypeHash(FStringView view)
+{
+	return GetBytesHash(view.GetData(), view.Len() * sizeof(TCHAR));
+}
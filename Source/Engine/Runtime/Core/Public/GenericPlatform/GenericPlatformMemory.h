@@ -3,24 +3,105 @@
 #include "HAL/Platform.h"
 #include <exception>
 
+enum class EPlatformPageBacking : u8
+{
+	// Regular pages of GetPageSize() bytes.
+	Default,
+
+	// Regular mapping that asks the kernel to back it with huge pages when it can.
+	TransparentHuge,
+
+	// Mapping backed by pages of GetHugePageSize() bytes taken from the reserved huge page pool.
+	// Falls back to TransparentHuge when the pool is empty or the privilege is missing.
+	ExplicitHuge
+};
+
 struct FGenericPlatformMemory
 {
-	FORCEINLINE static void* SystemMalloc(SIZE_T size)
+	FORCEINLINE static void* SystemMalloc(SIZE_T)
 	{
 		NOT_IMPLEMENTED()
+		return nullptr;
 	}
 
-	FORCEINLINE static void SystemFree(void* ptr)
+	FORCEINLINE static void SystemFree(void*)
 	{
 		NOT_IMPLEMENTED()
 	}
 
-	FORCEINLINE static bool TryGetMemorySize(void*& ptr, SIZE_T& outSize)
+	FORCEINLINE static bool TryGetMemorySize(void*, SIZE_T&)
 	{
 		return false;
 	}
 
 	[[noreturn]] FORCEINLINE static void OnOutOfMemory()
+	{
+		NOT_IMPLEMENTED()
+		std::terminate();
+	}
+
+public:
+
+	FORCEINLINE static SIZE_T GetPageSize()
+	{
+		return 4096;
+	}
+
+	FORCEINLINE static SIZE_T GetHugePageSize()
+	{
+		return 2 * 1024 * 1024;
+	}
+
+	FORCEINLINE static u64 GetTotalPhysicalMemory()
+	{
+		NOT_IMPLEMENTED()
+		return 0;
+	}
+
+public:
+
+	/**
+	 * Reserves a range of address space without backing it with physical memory.
+	 * Size is rounded up to the page size of the requested backing. Returns nullptr on failure.
+	 */
+	FORCEINLINE static void* ReserveAddressSpace(SIZE_T, EPlatformPageBacking = EPlatformPageBacking::Default)
+	{
+		NOT_IMPLEMENTED()
+		return nullptr;
+	}
+
+	/** Makes a page aligned sub range of a reservation readable and writable. */
+	FORCEINLINE static bool CommitPages(void*, SIZE_T)
+	{
+		NOT_IMPLEMENTED()
+		return false;
+	}
+
+	/** Returns the physical memory of a committed range to the system, keeping the address space reserved. */
+	FORCEINLINE static bool DecommitPages(void*, SIZE_T)
+	{
+		NOT_IMPLEMENTED()
+		return false;
+	}
+
+	/** Releases a whole reservation returned by ReserveAddressSpace. */
+	FORCEINLINE static void ReleaseAddressSpace(void*, SIZE_T)
+	{
+		NOT_IMPLEMENTED()
+	}
+
+	/**
+	 * Reserves and commits a range in one call. Returns nullptr on failure. The backing obtained may differ
+	 * from the one requested; it is written to outBacking and must be passed back to FreePages.
+	 */
+	FORCEINLINE static void* AllocatePages(SIZE_T, EPlatformPageBacking = EPlatformPageBacking::Default, EPlatformPageBacking* = nullptr)
+	{
+		NOT_IMPLEMENTED()
+		return nullptr;
+	}
+
+	/** Frees a range returned by AllocatePages, with the size it was requested with and the backing it got. */
+	FORCEINLINE static void FreePages(void*, SIZE_T, EPlatformPageBacking = EPlatformPageBacking::Default)
 	{
 		NOT_IMPLEMENTED()
 	}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+enum class ECPUFeature : u32
+{
+	SSE2 = 1 << 0,
+	SSE41 = 1 << 1,
+	AVX = 1 << 2,
+	AVX2 = 1 << 3,
+	FMA3 = 1 << 4,
+	NEON = 1 << 5,
+	F16C = 1 << 6
+};
+
+struct FGenericPlatformMisc
+{
+	/** Returns the ECPUFeature flags supported by both the processor and the operating system. */
+	FORCEINLINE static u32 GetCPUFeatures()
+	{
+		return 0;
+	}
+
+	FORCEINLINE static bool HasCPUFeature(ECPUFeature)
+	{
+		return false;
+	}
+};
@@ -2,3 +2,4 @@
 
 #include "HAL/Platform.h"
 #include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
\ No newline at end of file
@@ -28,6 +28,10 @@
 	#define PLATFORM_WINDOWS 0
 #endif
 
+#if !defined(PLATFORM_LINUX)
+	#define PLATFORM_LINUX 0
+#endif
+
 #if !defined(FORCEINLINE)
 	#define FORCEINLINE 
 #endif
@@ -52,6 +56,26 @@
 	#define NOT_IMPLEMENTED()
 #endif
 
+#if !defined(PLATFORM_RETURN_ADDRESS)
+	#define PLATFORM_RETURN_ADDRESS() nullptr
+#endif
+
+#if !defined(PLATFORM_CPU_X86_FAMILY)
+	#if defined(_M_IX86) || defined(__i386__) || defined(_M_X64) || defined(__x86_64__) || defined(__amd64__)
+		#define PLATFORM_CPU_X86_FAMILY 1
+	#else
+		#define PLATFORM_CPU_X86_FAMILY 0
+	#endif
+#endif
+
+#if !defined(PLATFORM_CPU_ARM_FAMILY)
+	#if defined(__arm__) || defined(_M_ARM) || defined(__aarch64__) || defined(_M_ARM64)
+		#define PLATFORM_CPU_ARM_FAMILY 1
+	#else
+		#define PLATFORM_CPU_ARM_FAMILY 0
+	#endif
+#endif
+
 // ---------------------------------------------------------------------------
 //	Computed defines
 // ---------------------------------------------------------------------------
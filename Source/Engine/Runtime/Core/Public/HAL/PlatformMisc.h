@@ -0,0 +1,5 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+#include COMPILED_PLATFORM_HEADER(PlatformMisc.h)
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "Linux/LinuxPlatform.h"
+#include "Linux/LinuxPlatformMemory.h"
+#include "Linux/LinuxPlatformMisc.h"
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "GenericPlatform/GenericPlatformTypes.h"
+
+#include <stddef.h>
+#include <sys/types.h>
+
+struct FLinuxPlatformTypes;
+typedef FLinuxPlatformTypes FPlatformTypes;
+
+struct FLinuxPlatformTypes : public FGenericPlatformTypes
+{
+	typedef size_t SIZE_T;
+	typedef ssize_t SSIZE_T;
+};
+
+#define CONSTEXPR constexpr
+
+#define GCC_ALIGN(n) __attribute__((aligned(n)))
+#define MS_ALIGN(n)
+
+#define FORCEINLINE inline __attribute__((always_inline))
+#define ABSTRACT
+#define DLLIMPORT __attribute__((visibility("default")))
+#define DLLEXPORT __attribute__((visibility("default")))
+#define PLATFORM_RETURN_ADDRESS() __builtin_return_address(0)
+
+#if defined(__x86_64__) || defined(__aarch64__) || defined(__LP64__)
+	#define PLATFORM_64BITS 1
+#else
+	#define PLATFORM_64BITS 0
+#endif
+
+#define PLATFORM_LINUX 1
+#define PLATFORM_DESKTOP 1
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "GenericPlatform/GenericPlatformMemory.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+struct FLinuxPlatformMemory;
+typedef FLinuxPlatformMemory FPlatformMemory;
+
+struct FLinuxPlatformMemory : public FGenericPlatformMemory
+{
+	FORCEINLINE static void* SystemMalloc(SIZE_T size)
+	{
+		void* ptr = malloc(size);
+
+		if (ptr == nullptr)
+		{
+			OnOutOfMemory();
+		}
+
+		return ptr;
+	}
+
+	FORCEINLINE static void SystemFree(void* ptr)
+	{
+		free(ptr);
+	}
+
+	FORCEINLINE static bool TryGetMemorySize(void* ptr, SIZE_T& outSize)
+	{
+		if (ptr == nullptr)
+		{
+			return false;
+		}
+
+		outSize = malloc_usable_size(ptr);
+		return true;
+	}
+
+	[[noreturn]] FORCEINLINE static void OnOutOfMemory()
+	{
+		abort();
+	}
+
+public:
+
+	FORCEINLINE static SIZE_T GetPageSize()
+	{
+		static const SIZE_T pageSize = (SIZE_T)sysconf(_SC_PAGESIZE);
+		return pageSize;
+	}
+
+	FORCEINLINE static SIZE_T GetHugePageSize()
+	{
+		static const SIZE_T hugePageSize = QueryHugePageSize();
+		return hugePageSize;
+	}
+
+	FORCEINLINE static u64 GetTotalPhysicalMemory()
+	{
+		static const u64 totalPhysicalMemory = (u64)sysconf(_SC_PHYS_PAGES) * (u64)sysconf(_SC_PAGESIZE);
+		return totalPhysicalMemory;
+	}
+
+public:
+
+	FORCEINLINE static void* ReserveAddressSpace(SIZE_T size, EPlatformPageBacking backing = EPlatformPageBacking::Default)
+	{
+		// Explicit huge pages are taken from the hugetlb pool at map time, so they can't be reserved lazily.
+		if (backing == EPlatformPageBacking::ExplicitHuge)
+		{
+			backing = EPlatformPageBacking::TransparentHuge;
+		}
+
+		return Map(size, PROT_NONE, MAP_NORESERVE, backing);
+	}
+
+	FORCEINLINE static bool CommitPages(void* ptr, SIZE_T size)
+	{
+		CHECK(IsPageAligned(ptr));
+		return mprotect(ptr, AlignToPageSize(size, GetPageSize()), PROT_READ | PROT_WRITE) == 0;
+	}
+
+	FORCEINLINE static bool DecommitPages(void* ptr, SIZE_T size)
+	{
+		CHECK(IsPageAligned(ptr));
+		size = AlignToPageSize(size, GetPageSize());
+
+		// MADV_DONTNEED drops the physical pages immediately; the next touch after a commit reads zeros.
+		if (madvise(ptr, size, MADV_DONTNEED) != 0)
+		{
+			return false;
+		}
+
+		return mprotect(ptr, size, PROT_NONE) == 0;
+	}
+
+	FORCEINLINE static void ReleaseAddressSpace(void* ptr, SIZE_T size)
+	{
+		Unmap(ptr, AlignToPageSize(size, GetPageSize()));
+	}
+
+	FORCEINLINE static void* AllocatePages(SIZE_T size, EPlatformPageBacking backing = EPlatformPageBacking::Default, EPlatformPageBacking* outBacking = nullptr)
+	{
+		if (backing == EPlatformPageBacking::ExplicitHuge)
+		{
+			void* ptr = Map(size, PROT_READ | PROT_WRITE, MAP_HUGETLB, backing);
+			if (ptr != nullptr)
+			{
+				if (outBacking != nullptr)
+				{
+					*outBacking = backing;
+				}
+
+				return ptr;
+			}
+
+			backing = EPlatformPageBacking::TransparentHuge;
+		}
+
+		if (outBacking != nullptr)
+		{
+			*outBacking = backing;
+		}
+
+		return Map(size, PROT_READ | PROT_WRITE, 0, backing);
+	}
+
+	FORCEINLINE static void FreePages(void* ptr, SIZE_T size, EPlatformPageBacking backing = EPlatformPageBacking::Default)
+	{
+		// hugetlb mappings were rounded up to whole huge pages, and munmap fails on any shorter length.
+		const SIZE_T pageSize = backing == EPlatformPageBacking::ExplicitHuge ? GetHugePageSize() : GetPageSize();
+		Unmap(ptr, AlignToPageSize(size, pageSize));
+	}
+
+private:
+
+	FORCEINLINE static SIZE_T AlignToPageSize(SIZE_T size, SIZE_T pageSize)
+	{
+		return (size + pageSize - 1) & ~(pageSize - 1);
+	}
+
+	FORCEINLINE static bool IsPageAligned(void* ptr)
+	{
+		return ((UPTRINT)ptr & (GetPageSize() - 1)) == 0;
+	}
+
+	FORCEINLINE static void Unmap(void* ptr, SIZE_T size)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		[[maybe_unused]] const int result = munmap(ptr, size);
+		CHECK(result == 0);
+	}
+
+	static void* Map(SIZE_T size, int protection, int extraFlags, EPlatformPageBacking backing)
+	{
+		const int flags = MAP_PRIVATE | MAP_ANONYMOUS | extraFlags;
+
+		if (backing == EPlatformPageBacking::ExplicitHuge)
+		{
+			void* ptr = mmap(nullptr, AlignToPageSize(size, GetHugePageSize()), protection, flags, -1, 0);
+			return ptr == MAP_FAILED ? nullptr : ptr;
+		}
+
+		if (backing == EPlatformPageBacking::Default)
+		{
+			void* ptr = mmap(nullptr, AlignToPageSize(size, GetPageSize()), protection, flags, -1, 0);
+			return ptr == MAP_FAILED ? nullptr : ptr;
+		}
+
+		// Transparent huge pages are only used for huge page aligned ranges, so over-map by one
+		// huge page and trim the unaligned head and tail. The tail is trimmed at page granularity
+		// so the range can be released with the same size it was requested with.
+		const SIZE_T hugePageSize = GetHugePageSize();
+		const SIZE_T alignedSize = AlignToPageSize(size, GetPageSize());
+		const SIZE_T mappedSize = alignedSize + hugePageSize;
+
+		u8* mapped = (u8*)mmap(nullptr, mappedSize, protection, flags, -1, 0);
+		if (mapped == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		u8* aligned = (u8*)AlignToPageSize((SIZE_T)mapped, hugePageSize);
+		const SIZE_T headSize = aligned - mapped;
+		const SIZE_T tailSize = mappedSize - headSize - alignedSize;
+
+		if (headSize > 0)
+		{
+			munmap(mapped, headSize);
+		}
+
+		if (tailSize > 0)
+		{
+			munmap(aligned + alignedSize, tailSize);
+		}
+
+#if defined(MADV_HUGEPAGE)
+		madvise(aligned, alignedSize, MADV_HUGEPAGE);
+#endif
+
+		return aligned;
+	}
+
+	static SIZE_T QueryHugePageSize()
+	{
+		SIZE_T hugePageSize = 2 * 1024 * 1024;
+
+		FILE* file = fopen("/proc/meminfo", "r");
+		if (file == nullptr)
+		{
+			return hugePageSize;
+		}
+
+		char line[256];
+		while (fgets(line, sizeof(line), file) != nullptr)
+		{
+			unsigned long long sizeInKb = 0;
+			if (sscanf(line, "Hugepagesize: %llu kB", &sizeInKb) == 1)
+			{
+				hugePageSize = (SIZE_T)sizeInKb * 1024;
+				break;
+			}
+		}
+
+		fclose(file);
+		return hugePageSize;
+	}
+};
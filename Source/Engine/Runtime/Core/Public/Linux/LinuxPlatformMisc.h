@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GenericPlatform/GenericPlatformMisc.h"
+
+struct FLinuxPlatformMisc;
+typedef FLinuxPlatformMisc FPlatformMisc;
+
+struct FLinuxPlatformMisc : public FGenericPlatformMisc
+{
+	FORCEINLINE static u32 GetCPUFeatures()
+	{
+		static const u32 features = QueryCPUFeatures();
+		return features;
+	}
+
+	FORCEINLINE static bool HasCPUFeature(ECPUFeature feature)
+	{
+		return (GetCPUFeatures() & (u32)feature) != 0;
+	}
+
+private:
+
+	static u32 QueryCPUFeatures()
+	{
+		u32 features = 0;
+
+#if PLATFORM_CPU_X86_FAMILY
+		// __builtin_cpu_supports also checks that the kernel saves the AVX registers.
+		__builtin_cpu_init();
+
+		features |= __builtin_cpu_supports("sse2") ? (u32)ECPUFeature::SSE2 : 0;
+		features |= __builtin_cpu_supports("sse4.1") ? (u32)ECPUFeature::SSE41 : 0;
+		features |= __builtin_cpu_supports("avx") ? (u32)ECPUFeature::AVX : 0;
+		features |= __builtin_cpu_supports("avx2") ? (u32)ECPUFeature::AVX2 : 0;
+		features |= __builtin_cpu_supports("fma") ? (u32)ECPUFeature::FMA3 : 0;
+		features |= __builtin_cpu_supports("f16c") ? (u32)ECPUFeature::F16C : 0;
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+		features |= (u32)ECPUFeature::NEON;
+#endif
+
+		return features;
+	}
+};
@@ -1,8 +1,18 @@
 #pragma once
 
 #include "Math/Math.h"
+#include "Math/VectorRegister.h"
 #include "Math/Vector.h"
 #include "Math/Vector2.h"
 #include "Math/Vector4.h"
+#include "Math/Color.h"
+#include "Math/VectorSoA.h"
 #include "Math/Matrix.h"
-#include "Math/Rect.h"
\ No newline at end of file
+#include "Math/Transform.h"
+#include "Math/Plane.h"
+#include "Math/Sphere.h"
+#include "Math/Box.h"
+#include "Math/Frustum.h"
+#include "Math/Rect.h"
+#include "Math/RectTree.h"
+#include "Math/Quantization.h"
\ No newline at end of file
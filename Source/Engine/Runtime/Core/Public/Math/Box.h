@@ -0,0 +1,105 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector.h"
+#include "Math/Sphere.h"
+#include "Math/Matrix.h"
+
+/** Axis aligned box between the corners Min and Max. */
+struct FBox
+{
+public:
+
+	FORCEINLINE FBox() : Min(0.f), Max(0.f) {}
+	FORCEINLINE FBox(const FVector& min, const FVector& max) : Min(min), Max(max) {}
+
+public:
+
+	FORCEINLINE static FBox FromCenterExtent(const FVector& center, const FVector& extent)
+	{
+		return FBox(center - extent, center + extent);
+	}
+
+	/** Smallest box holding the points, count must be at least one. */
+	FORCEINLINE static FBox FromPoints(const FVector* points, i32 count)
+	{
+		CHECK(count > 0);
+
+		FBox box(points[0], points[0]);
+		for (i32 i = 1; i < count; ++i)
+		{
+			box.Encapsulate(points[i]);
+		}
+		return box;
+	}
+
+public:
+
+	FORCEINLINE FVector GetCenter() const { return (Min + Max) * 0.5f; }
+	FORCEINLINE FVector GetExtent() const { return (Max - Min) * 0.5f; }
+	FORCEINLINE FVector GetSize() const { return Max - Min; }
+
+	FORCEINLINE bool Contains(const FVector& point) const
+	{
+		return point.X >= Min.X && point.X <= Max.X && point.Y >= Min.Y && point.Y <= Max.Y && point.Z >= Min.Z && point.Z <= Max.Z;
+	}
+
+	FORCEINLINE bool Intersects(const FBox& other) const
+	{
+		return Min.X <= other.Max.X && Max.X >= other.Min.X && Min.Y <= other.Max.Y && Max.Y >= other.Min.Y && Min.Z <= other.Max.Z && Max.Z >= other.Min.Z;
+	}
+
+	FORCEINLINE bool Intersects(const FSphere& sphere) const
+	{
+		const FVector closest
+		(
+			FMath::Clamp(sphere.Center.X, Min.X, Max.X),
+			FMath::Clamp(sphere.Center.Y, Min.Y, Max.Y),
+			FMath::Clamp(sphere.Center.Z, Min.Z, Max.Z)
+		);
+		return sphere.Contains(closest);
+	}
+
+	FORCEINLINE void Encapsulate(const FVector& point)
+	{
+		Min.X = FMath::Min(Min.X, point.X);
+		Min.Y = FMath::Min(Min.Y, point.Y);
+		Min.Z = FMath::Min(Min.Z, point.Z);
+		Max.X = FMath::Max(Max.X, point.X);
+		Max.Y = FMath::Max(Max.Y, point.Y);
+		Max.Z = FMath::Max(Max.Z, point.Z);
+	}
+
+	FORCEINLINE void Encapsulate(const FBox& other)
+	{
+		Encapsulate(other.Min);
+		Encapsulate(other.Max);
+	}
+
+	/** Box holding this one once transformed by an affine matrix. */
+	FORCEINLINE FBox TransformBy(const FMatrix& m) const
+	{
+		// The extent along each output axis is the extent weighted by the absolute values of its row.
+		const FVector center = m * GetCenter();
+		const FVector extent = GetExtent();
+
+		FVector newExtent;
+		for (i32 row = 0; row < 3; ++row)
+		{
+			newExtent[row] = FMath::Abs(m.M[row][0]) * extent.X + FMath::Abs(m.M[row][1]) * extent.Y + FMath::Abs(m.M[row][2]) * extent.Z;
+		}
+
+		return FromCenterExtent(center, newExtent);
+	}
+
+public:
+
+	FVector Min;
+	FVector Max;
+};
+
+template<> struct TIsTriviallyRelocatable<FBox> : FTrueType { };
+template<> struct TIsZeroConstructType<FBox> : FTrueType { };
+template<> struct TIsPODType<FBox> : FTrueType { };
+template<> struct TIsBitwiseComparable<FBox> : FTrueType { };
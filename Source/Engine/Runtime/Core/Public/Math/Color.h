@@ -0,0 +1,175 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector4.h"
+#include "Math/VectorRegister.h"
+
+namespace Private
+{
+	/** Returns (xyz.x, xyz.y, xyz.z, w.w). */
+	FORCEINLINE VectorRegister VectorWithW(VectorRegister xyz, VectorRegister w)
+	{
+		return VectorShuffle<0, 1, 0, 2>(xyz, VectorShuffle<2, 2, 3, 3>(xyz, w));
+	}
+
+	/**
+	 * Encodes linear channels to sRGB in [0, 255], clamping to [0, 1] first. The curve x^(1/2.4) is a
+	 * polynomial in x^(1/4) within 0.002 of a step, so rounding gives the correctly rounded byte unless the
+	 * exact value is that close to a tie.
+	 */
+	FORCEINLINE VectorRegister VectorEncodeSRGB(VectorRegister linear)
+	{
+		// The maximum first turns NaNs into zeros.
+		const VectorRegister c = VectorMin(VectorMax(linear, VectorZero()), VectorOne());
+		const VectorRegister threshold = VectorSetFloat1(0.0031308f);
+
+		// The polynomial is fitted on s in [-1, 1], mapped from x^(1/4) in [threshold^(1/4), 1].
+		const VectorRegister root = VectorSqrt(VectorSqrt(VectorMax(c, threshold)));
+		const VectorRegister s = VectorMultiplyAdd(root, VectorSetFloat1(2.6196699f), VectorSetFloat1(-1.6196699f));
+
+		VectorRegister curve = VectorSetFloat1(-0.140848957f);
+		curve = VectorMultiplyAdd(curve, s, VectorSetFloat1(0.427011641f));
+		curve = VectorMultiplyAdd(curve, s, VectorSetFloat1(-1.72963379f));
+		curve = VectorMultiplyAdd(curve, s, VectorSetFloat1(25.5377083f));
+		curve = VectorMultiplyAdd(curve, s, VectorSetFloat1(124.21312f));
+		curve = VectorMultiplyAdd(curve, s, VectorSetFloat1(106.690968f));
+
+		return VectorSelect(VectorCompareLE(c, threshold), VectorMultiply(c, VectorSetFloat1(12.92f * 255.0f)), curve);
+	}
+
+	/** Clamps linear alpha to [0, 1] and scales it to [0, 255]. */
+	FORCEINLINE VectorRegister VectorEncodeAlpha(VectorRegister alpha)
+	{
+		return VectorMultiply(VectorMin(VectorMax(alpha, VectorZero()), VectorOne()), VectorSetFloat1(255.0f));
+	}
+
+	/** Encodes a linear (R, G, B, A) color to [0, 255], R, G and B to sRGB, see VectorEncodeSRGB. */
+	FORCEINLINE VectorRegister VectorLinearToSRGB(VectorRegister color)
+	{
+		return VectorWithW(VectorEncodeSRGB(color), VectorEncodeAlpha(color));
+	}
+}
+
+/** RGBA color with 8 bits per channel, R, G and B being sRGB encoded. */
+struct FColor32
+{
+public:
+
+	static const FColor32 Clear;
+	static const FColor32 Black;
+	static const FColor32 White;
+	static const FColor32 Red;
+	static const FColor32 Green;
+	static const FColor32 Blue;
+	static const FColor32 Yellow;
+	static const FColor32 Cyan;
+	static const FColor32 Magenta;
+	static const FColor32 Orange;
+	static const FColor32 Purple;
+	static const FColor32 Turquoise;
+	static const FColor32 Silver;
+	static const FColor32 Emerald;
+
+	/** sRGB encoded channel to linear. */
+	static const float SRGBToLinearTable[256];
+
+public:
+
+	FORCEINLINE CONSTEXPR FColor32() : R(0), G(0), B(0), A(0) {}
+	FORCEINLINE CONSTEXPR FColor32(u8 r, u8 g, u8 b, u8 a = 255) : R(r), G(g), B(b), A(a) {}
+	CONSTEXPR FColor32(const FColor32&) = default;
+	CONSTEXPR FColor32& operator=(const FColor32&) = default;
+
+	FORCEINLINE FColor32(const FColor32& c, u8 a) : UnsingnedIntValue(c.UnsingnedIntValue)
+	{
+		A = a;
+	}
+
+	FORCEINLINE FColor32(const FColor32& c, float a) : UnsingnedIntValue(c.UnsingnedIntValue)
+	{
+		A = (u8)(a * 255.f);
+	}
+
+public: 
+
+	FORCEINLINE const u8& operator[](const i32 index) const
+	{
+		CHECK(index >= 0 && index < 4);
+		return Components[index];
+	}
+
+	FORCEINLINE u8& operator[](const i32 index)
+	{
+		CHECK(index >= 0 && index < 4);
+		return Components[index];
+	}
+
+public:
+
+	/** Returns the color in linear space as (R, G, B, A), R, G and B decoded from sRGB. */
+	FORCEINLINE FVector4 ToLinear() const
+	{
+		return FVector4(SRGBToLinearTable[R], SRGBToLinearTable[G], SRGBToLinearTable[B], A * (1.0f / 255.0f));
+	}
+
+	/** Encodes a linear (R, G, B, A) color, R, G and B to sRGB. Components are clamped to [0, 1]. */
+	FORCEINLINE static FColor32 FromLinear(const FVector4& color)
+	{
+		FColor32 result;
+		VectorStoreByte4(Private::VectorLinearToSRGB(color.ToRegister()), result.Components);
+		return result;
+	}
+
+public:
+
+	// Batch versions over whole images or vertex color streams, with the same results as the functions above.
+	// Linear colors are held in FVector4 as (R, G, B, A).
+
+	static void ToLinearArray(const FColor32* source, FVector4* dest, i32 count);
+	static void FromLinearArray(const FVector4* source, FColor32* dest, i32 count);
+
+	/** Multiplies R, G and B of linear colors by their alpha, in place. */
+	static void PremultiplyAlphaArray(FVector4* colors, i32 count);
+
+	/** Composites premultiplied linear colors over dest, dest = source + dest * (1 - source.A). */
+	static void BlendArray(const FVector4* source, FVector4* dest, i32 count);
+
+	/** Composites colors with straight alpha over dest, blending in linear space. */
+	static void BlendArray(const FColor32* source, FColor32* dest, i32 count);
+
+public:
+
+	union
+	{
+		u32 UnsingnedIntValue;
+		i32 SignedIntValue;
+
+		struct
+		{
+			u8 R, G, B, A;
+		};
+
+		u8 Components[4];
+	};
+};
+
+inline constexpr FColor32 FColor32::Clear(0, 0, 0, 0);
+inline constexpr FColor32 FColor32::Black(0, 0, 0);
+inline constexpr FColor32 FColor32::White(255, 255, 255);
+inline constexpr FColor32 FColor32::Red(255, 0, 0);
+inline constexpr FColor32 FColor32::Green(0, 255, 0);
+inline constexpr FColor32 FColor32::Blue(0, 0, 255);
+inline constexpr FColor32 FColor32::Yellow(255, 255, 0);
+inline constexpr FColor32 FColor32::Cyan(0, 255, 255);
+inline constexpr FColor32 FColor32::Magenta(255, 0, 255);
+inline constexpr FColor32 FColor32::Orange(255, 165, 0);
+inline constexpr FColor32 FColor32::Purple(128, 0, 128);
+inline constexpr FColor32 FColor32::Turquoise(64, 224, 208);
+inline constexpr FColor32 FColor32::Silver(192, 192, 192);
+inline constexpr FColor32 FColor32::Emerald(80, 200, 120);
+
+template<> struct TIsTriviallyRelocatable<FColor32> : FTrueType { };
+template<> struct TIsZeroConstructType<FColor32> : FTrueType { };
+template<> struct TIsPODType<FColor32> : FTrueType { };
+template<> struct TIsBitwiseComparable<FColor32> : FTrueType { };
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector.h"
+#include "Math/Matrix.h"
+#include "Math/Plane.h"
+#include "Math/Sphere.h"
+#include "Math/Box.h"
+
+/** Six planes facing inward: left, right, bottom, top, near and far. */
+struct FFrustum
+{
+public:
+
+	static constexpr i32 NumPlanes = 6;
+
+public:
+
+	FORCEINLINE FFrustum() {}
+
+	/**
+	 * Extracts the planes of a view projection matrix mapping points to clip space with -w <= x, y <= w and
+	 * 0 <= z <= w. The planes are normalized, so PlaneDot gives distances in world units.
+	 */
+	FORCEINLINE explicit FFrustum(const FMatrix& viewProjection)
+	{
+		const FVector4& r0 = viewProjection.Rows[0];
+		const FVector4& r1 = viewProjection.Rows[1];
+		const FVector4& r2 = viewProjection.Rows[2];
+		const FVector4& r3 = viewProjection.Rows[3];
+
+		Planes[0] = FPlane(r3.X + r0.X, r3.Y + r0.Y, r3.Z + r0.Z, r3.W + r0.W).GetNormalized();
+		Planes[1] = FPlane(r3.X - r0.X, r3.Y - r0.Y, r3.Z - r0.Z, r3.W - r0.W).GetNormalized();
+		Planes[2] = FPlane(r3.X + r1.X, r3.Y + r1.Y, r3.Z + r1.Z, r3.W + r1.W).GetNormalized();
+		Planes[3] = FPlane(r3.X - r1.X, r3.Y - r1.Y, r3.Z - r1.Z, r3.W - r1.W).GetNormalized();
+		Planes[4] = FPlane(r2.X, r2.Y, r2.Z, r2.W).GetNormalized();
+		Planes[5] = FPlane(r3.X - r2.X, r3.Y - r2.Y, r3.Z - r2.Z, r3.W - r2.W).GetNormalized();
+	}
+
+public:
+
+	FORCEINLINE bool Contains(const FVector& point) const
+	{
+		for (i32 plane = 0; plane < NumPlanes; ++plane)
+		{
+			if (Planes[plane].PlaneDot(point) < 0.f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Conservative: spheres crossing the corners of the frustum from outside may pass. */
+	FORCEINLINE bool Intersects(const FSphere& sphere) const
+	{
+		for (i32 plane = 0; plane < NumPlanes; ++plane)
+		{
+			if (Planes[plane].PlaneDot(sphere.Center) < -sphere.Radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Conservative like the sphere test. */
+	FORCEINLINE bool Intersects(const FBox& box) const
+	{
+		const FVector center = box.GetCenter();
+		const FVector extent = box.GetExtent();
+
+		for (i32 plane = 0; plane < NumPlanes; ++plane)
+		{
+			const FPlane& p = Planes[plane];
+			const float radius = FMath::Abs(p.X) * extent.X + FMath::Abs(p.Y) * extent.Y + FMath::Abs(p.Z) * extent.Z;
+			if (p.PlaneDot(center) < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+
+	// Batch culling over SoA bounds, one array per component, boxes given by center and extent. Writes the
+	// indices of the bounds passing the test above, in increasing order, to outVisibleIndices, which must
+	// have room for count entries, and returns how many were written.
+
+	i32 CullSpheres(const float* centerX, const float* centerY, const float* centerZ, const float* radii, i32 count, i32* outVisibleIndices) const;
+	i32 CullBoxes(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, i32 count, i32* outVisibleIndices) const;
+
+public:
+
+	FPlane Planes[NumPlanes];
+};
+
+template<> struct TIsTriviallyRelocatable<FFrustum> : FTrueType { };
+template<> struct TIsZeroConstructType<FFrustum> : FTrueType { };
+template<> struct TIsPODType<FFrustum> : FTrueType { };
+template<> struct TIsBitwiseComparable<FFrustum> : FTrueType { };
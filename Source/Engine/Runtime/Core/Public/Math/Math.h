@@ -1,16 +1,13 @@
 #pragma once
 
 #include "HAL/Platform.h"
+#include "Math/VectorMath.h"
 
 #include <cmath> 
 
 
 struct FMath
 {
-private:
-
-	union IntFloatUnion;
-
 public:
 
 	CONSTEXPR static float Pi = 3.14159265358979323f;
@@ -29,19 +26,28 @@ public:
 
 public:
 
+	/** Correctly rounded, from the hardware square root. */
 	FORCEINLINE static float Sqrt(float value)
 	{
-		IntFloatUnion Union(value);
-		Union.Int = (1 << 29) + (Union.Int >> 1) - (1 << 22);
-		Union.Float = Union.Float + value / Union.Float;
-		return 0.25f * Union.Float + value / Union.Float;
+		return VectorGetComponent<0>(VectorSqrt(VectorSetFloat1(value)));
 	}
 
+	/** Max error 1.5 ULP, see VectorReciprocalSqrt. */
 	FORCEINLINE static float InvSqrt(const float value)
 	{
-		IntFloatUnion Union(value);
-		Union.Int = 0x5F3759DF - (Union.Int >> 1);
-		return Union.Float * (1.5f - (0.5f * value * Union.Float * Union.Float));
+		return VectorGetComponent<0>(VectorReciprocalSqrt(VectorSetFloat1(value)));
+	}
+
+	/** Hardware estimate, about 12 bits of precision. */
+	FORCEINLINE static float InvSqrtEstimate(const float value)
+	{
+		return VectorGetComponent<0>(VectorReciprocalSqrtEstimate(VectorSetFloat1(value)));
+	}
+
+	/** Rounds to the nearest integer, ties to even, like VectorRound. value must be within the i32 range. */
+	FORCEINLINE static float Round(const float value)
+	{
+		return VectorGetComponent<0>(VectorRound(VectorSetFloat1(value)));
 	}
 
 public:
@@ -111,22 +117,56 @@ public:
 
 public:
 
-	FORCEINLINE static float Sin(float Radians) { return sin(Radians); }
-	FORCEINLINE static float Cos(const float Randians) { return cos(Randians); }
-	FORCEINLINE static float Tan(const float Randians) { return tan(Randians); }
-	FORCEINLINE static float Asin(const float Value) { return asin(Value); }
-	FORCEINLINE static float Acos(const float Value) { return acos(Value); }
-	FORCEINLINE static float Atan(const float Value) { return atan(Value); }
-	FORCEINLINE static float Atan2(const float Y, const float X) { return atan2(Y, X); }
+	/** Returns the index of the lowest set bit, or 64 if value is zero. */
+	FORCEINLINE static u32 CountTrailingZeros64(u64 value)
+	{
+		if (value == 0)
+		{
+			return 64;
+		}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return (u32)index;
+#else
+		return (u32)__builtin_ctzll(value);
+#endif
+	}
 
-private:
+public:
+
+	// Polynomial kernels from Math/VectorMath.h, see there for their error bounds. Tan stays on the C library.
+	// Unlike the C library, Sin, Cos and SinCos lose precision for |Radians| > 8192: the absolute error grows
+	// to about 1e-6 at 65536 and 0.03 at 1e6. Wrap large angles into [-pi, pi] before calling them.
+
+	FORCEINLINE static void SinCos(const float Radians, float& OutSin, float& OutCos)
+	{
+		VectorRegister sin, cos;
+		VectorSinCos(VectorSetFloat1(Radians), sin, cos);
+		OutSin = VectorGetComponent<0>(sin);
+		OutCos = VectorGetComponent<0>(cos);
+	}
 
-	union IntFloatUnion
+	FORCEINLINE static float Sin(float Radians)
 	{
-		i32 Int;
-		float Float;
+		float sin, cos;
+		SinCos(Radians, sin, cos);
+		return sin;
+	}
 
-		FORCEINLINE IntFloatUnion(const i32 InInt) { Int = InInt; }
-		FORCEINLINE IntFloatUnion(const float InFloat) { Float = InFloat; }
-	};
+	FORCEINLINE static float Cos(const float Randians)
+	{
+		float sin, cos;
+		SinCos(Randians, sin, cos);
+		return cos;
+	}
+
+	FORCEINLINE static float Tan(const float Randians) { return tan(Randians); }
+	FORCEINLINE static float Asin(const float Value) { return VectorGetComponent<0>(VectorAsin(VectorSetFloat1(Value))); }
+	FORCEINLINE static float Acos(const float Value) { return VectorGetComponent<0>(VectorAcos(VectorSetFloat1(Value))); }
+	FORCEINLINE static float Atan(const float Value) { return Atan2(Value, 1.0f); }
+	FORCEINLINE static float Atan2(const float Y, const float X) { return VectorGetComponent<0>(VectorAtan2(VectorSetFloat1(Y), VectorSetFloat1(X))); }
+	FORCEINLINE static float Exp(const float Value) { return VectorGetComponent<0>(VectorExp(VectorSetFloat1(Value))); }
+	FORCEINLINE static float Log(const float Value) { return VectorGetComponent<0>(VectorLog(VectorSetFloat1(Value))); }
 };
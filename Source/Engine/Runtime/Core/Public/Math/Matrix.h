@@ -6,7 +6,30 @@
 #include "Math/Quat.h"
 #include "Math/Math.h"
 
-struct FMatrix
+namespace Private
+{
+	// A register holding a row major 2x2 matrix (m00, m01, m10, m11), used by the block matrix inverse.
+
+	/** Returns a * b. */
+	FORCEINLINE VectorRegister Matrix2Multiply(VectorRegister a, VectorRegister b)
+	{
+		return VectorAdd(VectorMultiply(a, VectorSwizzle<0, 3, 0, 3>(b)), VectorMultiply(VectorSwizzle<1, 0, 3, 2>(a), VectorSwizzle<2, 1, 2, 1>(b)));
+	}
+
+	/** Returns adj(a) * b. */
+	FORCEINLINE VectorRegister Matrix2AdjointMultiply(VectorRegister a, VectorRegister b)
+	{
+		return VectorSubtract(VectorMultiply(VectorSwizzle<3, 3, 0, 0>(a), b), VectorMultiply(VectorSwizzle<1, 1, 2, 2>(a), VectorSwizzle<2, 3, 0, 1>(b)));
+	}
+
+	/** Returns a * adj(b). */
+	FORCEINLINE VectorRegister Matrix2MultiplyAdjoint(VectorRegister a, VectorRegister b)
+	{
+		return VectorSubtract(VectorMultiply(a, VectorSwizzle<3, 0, 3, 0>(b)), VectorMultiply(VectorSwizzle<1, 0, 3, 2>(a), VectorSwizzle<2, 1, 2, 1>(b)));
+	}
+}
+
+struct MS_ALIGN(16) FMatrix
 {
 public:
 
@@ -14,28 +37,17 @@ public:
 
 public:
 
-	FORCEINLINE FMatrix()
+	FORCEINLINE CONSTEXPR FMatrix()
+		: Rows{}
 	{
-		Rows[0] = FVector4::Zero;
-		Rows[1] = FVector4::Zero;
-		Rows[2] = FVector4::Zero;
-		Rows[3] = FVector4::Zero;
 	}
 
-	FORCEINLINE FMatrix(const FMatrix& Other)
-	{
-		Rows[0] = Other.Rows[0];
-		Rows[1] = Other.Rows[1];
-		Rows[2] = Other.Rows[2];
-		Rows[3] = Other.Rows[3];
-	}
+	CONSTEXPR FMatrix(const FMatrix&) = default;
+	CONSTEXPR FMatrix& operator=(const FMatrix&) = default;
 
-	FORCEINLINE FMatrix(FVector4 r0, FVector4 r1, FVector4 r2, FVector4 r3)
+	FORCEINLINE CONSTEXPR FMatrix(const FVector4& r0, const FVector4& r1, const FVector4& r2, const FVector4& r3)
+		: Rows{ r0, r1, r2, r3 }
 	{
-		Rows[0] = r0;
-		Rows[1] = r1;
-		Rows[2] = r2;
-		Rows[3] = r3;
 	}
 
 public:
@@ -43,46 +55,40 @@ public:
 	FORCEINLINE FMatrix operator*(const FMatrix& other) const
 	{
 		FMatrix result;
-
-		for (i32 Row = 0; Row < 4; ++Row)
-		{
-			for (i32 Col = 0; Col < 4; ++Col)
-			{
-				result.M[Row][Col] = Rows[Row][0] * other.M[0][Col]
-					+ Rows[Row][1] * other.M[1][Col]
-					+ Rows[Row][2] * other.M[2][Col]
-					+ Rows[Row][3] * other.M[3][Col];
-			}
-		}
-
+		VectorMatrixMultiply(result.Elements, Elements, other.Elements);
 		return result;
 	}
 
 	FORCEINLINE FVector operator*(const FVector& other) const
 	{
-		FVector result;
+		// Weights the columns of the upper three rows by (x, y, z, 1), then sums each row through a transpose.
+		const VectorRegister v = VectorSet(other.X, other.Y, other.Z, 1.0f);
 
-		result.X = Rows[0][0] * other.X + Rows[0][1] * other.Y + Rows[0][2] * other.Z + Rows[0][3];
-		result.Y = Rows[1][0] * other.X + Rows[1][1] * other.Y + Rows[1][2] * other.Z + Rows[1][3];
-		result.Z = Rows[2][0] * other.X + Rows[2][1] * other.Y + Rows[2][2] * other.Z + Rows[2][3];
+		VectorRegister r0 = VectorMultiply(VectorLoadAligned(Elements + 0), v);
+		VectorRegister r1 = VectorMultiply(VectorLoadAligned(Elements + 4), v);
+		VectorRegister r2 = VectorMultiply(VectorLoadAligned(Elements + 8), v);
+		VectorRegister r3 = VectorZero();
+		VectorTranspose4x4(r0, r1, r2, r3);
 
-		return result;
+		const FVector4 result(VectorAdd(VectorAdd(r0, r1), VectorAdd(r2, r3)));
+		return FVector(result.X, result.Y, result.Z);
 	}
 
 public:
 
 	FORCEINLINE FMatrix Transpose() const
 	{
-		FMatrix result;
-
-		for (i32 Row = 0; Row < 4; ++Row)
-		{
-			for (i32 Col = 0; Col < 4; ++Col)
-			{
-				result.M[Row][Col] = M[Col][Row];
-			}
-		}
+		VectorRegister r0 = VectorLoadAligned(Elements + 0);
+		VectorRegister r1 = VectorLoadAligned(Elements + 4);
+		VectorRegister r2 = VectorLoadAligned(Elements + 8);
+		VectorRegister r3 = VectorLoadAligned(Elements + 12);
+		VectorTranspose4x4(r0, r1, r2, r3);
 
+		FMatrix result;
+		VectorStoreAligned(r0, result.Elements + 0);
+		VectorStoreAligned(r1, result.Elements + 4);
+		VectorStoreAligned(r2, result.Elements + 8);
+		VectorStoreAligned(r3, result.Elements + 12);
 		return result;
 	}
 
@@ -113,32 +119,109 @@ public:
 				);
 	}
 
+	/**
+	 * General inverse, computed blockwise from the four 2x2 sub matrices. Returns the identity when the
+	 * matrix is singular. Prefer InverseAffine or InverseRigid when the matrix is known to be one of those.
+	 */
 	FORCEINLINE FMatrix Inverse() const
 	{
-		FMatrix inverse;
-		float det = GetDeterminant();
+		const VectorRegister r0 = VectorLoadAligned(Elements + 0);
+		const VectorRegister r1 = VectorLoadAligned(Elements + 4);
+		const VectorRegister r2 = VectorLoadAligned(Elements + 8);
+		const VectorRegister r3 = VectorLoadAligned(Elements + 12);
+
+		// | A B |
+		// | C D |
+		const VectorRegister a = VectorShuffle<0, 1, 0, 1>(r0, r1);
+		const VectorRegister b = VectorShuffle<2, 3, 2, 3>(r0, r1);
+		const VectorRegister c = VectorShuffle<0, 1, 0, 1>(r2, r3);
+		const VectorRegister d = VectorShuffle<2, 3, 2, 3>(r2, r3);
+
+		// (|A|, |B|, |C|, |D|)
+		const VectorRegister subDeterminants = VectorSubtract
+		(
+			VectorMultiply(VectorShuffle<0, 2, 0, 2>(r0, r2), VectorShuffle<1, 3, 1, 3>(r1, r3)),
+			VectorMultiply(VectorShuffle<1, 3, 1, 3>(r0, r2), VectorShuffle<0, 2, 0, 2>(r1, r3))
+		);
+
+		const VectorRegister detA = VectorReplicate<0>(subDeterminants);
+		const VectorRegister detB = VectorReplicate<1>(subDeterminants);
+		const VectorRegister detC = VectorReplicate<2>(subDeterminants);
+		const VectorRegister detD = VectorReplicate<3>(subDeterminants);
 
-		if (det == 0)
+		const VectorRegister adjDC = Private::Matrix2AdjointMultiply(d, c);
+		const VectorRegister adjAB = Private::Matrix2AdjointMultiply(a, b);
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		VectorRegister det = VectorAdd(VectorMultiply(detA, detD), VectorMultiply(detB, detC));
+		det = VectorSubtract(det, VectorDot4(adjAB, VectorSwizzle<0, 2, 1, 3>(adjDC)));
+
+		if (VectorGetComponent<0>(det) == 0.0f)
 		{
 			return FMatrix::Identity;
 		}
 
-		float invDet = 1.0f / det;
+		// Adjoints of the blocks of the inverse, scaled by the signs of the 2x2 adjoint.
+		const VectorRegister invDet = VectorDivide(VectorSet(1.0f, -1.0f, -1.0f, 1.0f), det);
+		const VectorRegister x = VectorMultiply(VectorSubtract(VectorMultiply(detD, a), Private::Matrix2Multiply(b, adjDC)), invDet);
+		const VectorRegister y = VectorMultiply(VectorSubtract(VectorMultiply(detB, c), Private::Matrix2MultiplyAdjoint(d, adjAB)), invDet);
+		const VectorRegister z = VectorMultiply(VectorSubtract(VectorMultiply(detC, b), Private::Matrix2MultiplyAdjoint(a, adjDC)), invDet);
+		const VectorRegister w = VectorMultiply(VectorSubtract(VectorMultiply(detA, d), Private::Matrix2Multiply(c, adjAB)), invDet);
 
-		for (int i = 0; i < 4; ++i)
+		FMatrix result;
+		VectorStoreAligned(VectorShuffle<3, 1, 3, 1>(x, y), result.Elements + 0);
+		VectorStoreAligned(VectorShuffle<2, 0, 2, 0>(x, y), result.Elements + 4);
+		VectorStoreAligned(VectorShuffle<3, 1, 3, 1>(z, w), result.Elements + 8);
+		VectorStoreAligned(VectorShuffle<2, 0, 2, 0>(z, w), result.Elements + 12);
+		return result;
+	}
+
+	/**
+	 * Inverse of a matrix whose last row is (0, 0, 0, 1), such as a TRS matrix, with or without scale and
+	 * shear. Returns the identity when the matrix is singular.
+	 */
+	FORCEINLINE FMatrix InverseAffine() const
+	{
+		VectorRegister a = VectorLoadAligned(Elements + 0);
+		VectorRegister b = VectorLoadAligned(Elements + 4);
+		VectorRegister c = VectorLoadAligned(Elements + 8);
+		VectorRegister translation = VectorZero();
+		VectorTranspose4x4(a, b, c, translation);
+
+		// The rows of the inverse of a 3x3 matrix are the cross products of its columns over the determinant.
+		VectorRegister i0 = VectorCross3(b, c);
+		VectorRegister i1 = VectorCross3(c, a);
+		VectorRegister i2 = VectorCross3(a, b);
+
+		const VectorRegister det = VectorDot4(a, i0);
+		if (VectorGetComponent<0>(det) == 0.0f)
 		{
-			for (int j = 0; j < 4; ++j)
-			{
-				inverse.M[i][j] /= invDet;
-			}
+			return FMatrix::Identity;
 		}
 
-		return inverse;
+		const VectorRegister invDet = VectorDivide(VectorOne(), det);
+		i0 = VectorMultiply(i0, invDet);
+		i1 = VectorMultiply(i1, invDet);
+		i2 = VectorMultiply(i2, invDet);
+
+		return FromInverseBasis(i0, i1, i2, translation);
+	}
+
+	/** Inverse of a matrix made of a rotation and a translation only, the 3x3 part is transposed. */
+	FORCEINLINE FMatrix InverseRigid() const
+	{
+		VectorRegister i0 = VectorLoadAligned(Elements + 0);
+		VectorRegister i1 = VectorLoadAligned(Elements + 4);
+		VectorRegister i2 = VectorLoadAligned(Elements + 8);
+		VectorRegister translation = VectorZero();
+		VectorTranspose4x4(i0, i1, i2, translation);
+
+		return FromInverseBasis(i0, i1, i2, translation);
 	}
 
 public:
 
-	FORCEINLINE static FMatrix Translation(const FVector& translation)
+	FORCEINLINE CONSTEXPR static FMatrix Translation(const FVector& translation)
 	{
 		return FMatrix
 		(
@@ -150,7 +233,7 @@ public:
 	}
 
 
-	FORCEINLINE static FMatrix Scale(const FVector& scale)
+	FORCEINLINE CONSTEXPR static FMatrix Scale(const FVector& scale)
 	{
 		return FMatrix
 		(
@@ -161,30 +244,30 @@ public:
 		);
 	}
 
-	FORCEINLINE static FMatrix Rotation(FQuat rotation)
+	FORCEINLINE CONSTEXPR static FMatrix Rotation(const FQuat& rotation)
 	{
-		float x2 = rotation.X + rotation.X;
-		float y2 = rotation.Y + rotation.Y;
-		float z2 = rotation.Z + rotation.Z;
+		const float x2 = rotation.X + rotation.X;
+		const float y2 = rotation.Y + rotation.Y;
+		const float z2 = rotation.Z + rotation.Z;
 
-		float xx2 = rotation.X * x2;
-		float yy2 = rotation.Y * y2;
-		float zz2 = rotation.Z * z2;
+		const float xx2 = rotation.X * x2;
+		const float yy2 = rotation.Y * y2;
+		const float zz2 = rotation.Z * z2;
 
-		float yz2 = rotation.Y * z2;
-		float wx2 = rotation.W * x2;
+		const float yz2 = rotation.Y * z2;
+		const float wx2 = rotation.W * x2;
 
-		float xy2 = rotation.X * y2;
-		float wz2 = rotation.W * z2;
+		const float xy2 = rotation.X * y2;
+		const float wz2 = rotation.W * z2;
 
-		float xz2 = rotation.X * z2;
-		float wy2 = rotation.W * y2;
+		const float xz2 = rotation.X * z2;
+		const float wy2 = rotation.W * y2;
 
 		return FMatrix
 		(
-			FVector4(1.0f - yy2 - zz2, xy2 + wz2, xz2 - wy2, 0.0f),
-			FVector4(xy2 - wz2, 1.0f - xx2 - zz2, yz2 + wx2, 0.0f),
-			FVector4(xz2 + wy2, yz2 - wx2, 1.0f - xx2 - yy2, 0.0f),
+			FVector4(1.0f - yy2 - zz2, xy2 - wz2, xz2 + wy2, 0.0f),
+			FVector4(xy2 + wz2, 1.0f - xx2 - zz2, yz2 - wx2, 0.0f),
+			FVector4(xz2 - wy2, yz2 + wx2, 1.0f - xx2 - yy2, 0.0f),
 			FVector4(0.0f, 0.0f, 0.0f, 1.0f)
 		);
 	}
@@ -199,6 +282,36 @@ public:
 		return Translation(translation) * Rotation(rotation);
 	}
 
+public:
+
+	// Batch transforms over contiguous arrays. Source and dest may be the same array. Points have an implicit
+	// W of 1 and pick up the translation, directions have a W of 0. TransformPositionsToClip applies all four
+	// rows, e.g. of a view projection matrix, and keeps W for the perspective divide.
+	// The SoA overloads take one array per component. Large counts are split across threads.
+
+	void TransformPoints(const FVector* source, FVector* dest, i32 count) const;
+	void TransformDirections(const FVector* source, FVector* dest, i32 count) const;
+	void TransformPositionsToClip(const FVector* source, FVector4* dest, i32 count) const;
+
+	void TransformPoints(const float* sourceX, const float* sourceY, const float* sourceZ, float* destX, float* destY, float* destZ, i32 count) const;
+	void TransformDirections(const float* sourceX, const float* sourceY, const float* sourceZ, float* destX, float* destY, float* destZ, i32 count) const;
+	void TransformPositionsToClip(const float* sourceX, const float* sourceY, const float* sourceZ, float* destX, float* destY, float* destZ, float* destW, i32 count) const;
+
+private:
+
+	/** Builds the inverse of an affine matrix from the rows of its inverted 3x3 part (W zero) and its translation. */
+	FORCEINLINE static FMatrix FromInverseBasis(VectorRegister i0, VectorRegister i1, VectorRegister i2, VectorRegister translation)
+	{
+		const VectorRegister axisW = VectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+
+		FMatrix result;
+		VectorStoreAligned(VectorSubtract(i0, VectorMultiply(VectorDot4(i0, translation), axisW)), result.Elements + 0);
+		VectorStoreAligned(VectorSubtract(i1, VectorMultiply(VectorDot4(i1, translation), axisW)), result.Elements + 4);
+		VectorStoreAligned(VectorSubtract(i2, VectorMultiply(VectorDot4(i2, translation), axisW)), result.Elements + 8);
+		VectorStoreAligned(axisW, result.Elements + 12);
+		return result;
+	}
+
 public:
 
 	union
@@ -207,4 +320,17 @@ public:
 		float Elements[16];
 		FVector4 Rows[4];
 	};
-};
\ No newline at end of file
+} GCC_ALIGN(16);
+
+inline constexpr FMatrix FMatrix::Identity
+(
+	FVector4(1.0f, 0.0f, 0.0f, 0.0f),
+	FVector4(0.0f, 1.0f, 0.0f, 0.0f),
+	FVector4(0.0f, 0.0f, 1.0f, 0.0f),
+	FVector4(0.0f, 0.0f, 0.0f, 1.0f)
+);
+
+template<> struct TIsTriviallyRelocatable<FMatrix> : FTrueType { };
+template<> struct TIsZeroConstructType<FMatrix> : FTrueType { };
+template<> struct TIsPODType<FMatrix> : FTrueType { };
+template<> struct TIsBitwiseComparable<FMatrix> : FTrueType { };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector.h"
+
+/** Plane through the points p with X * p.X + Y * p.Y + Z * p.Z + W = 0, its normal being (X, Y, Z). */
+struct FPlane
+{
+public:
+
+	FORCEINLINE FPlane() : X(0.f), Y(0.f), Z(0.f), W(0.f) {}
+	FORCEINLINE FPlane(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+	FORCEINLINE FPlane(const FVector& normal, float w) : X(normal.X), Y(normal.Y), Z(normal.Z), W(w) {}
+	FORCEINLINE FPlane(const FVector& normal, const FVector& point) : X(normal.X), Y(normal.Y), Z(normal.Z), W(-FVector::Dot(normal, point)) {}
+
+public:
+
+	/** Plane through three points, its normal facing the side they wind counter clockwise from. */
+	FORCEINLINE static FPlane FromPoints(const FVector& a, const FVector& b, const FVector& c)
+	{
+		return FPlane(FVector::Cross(b - a, c - a).GetNormalized(), a);
+	}
+
+public:
+
+	/** Signed distance from the plane when the normal has unit length, scaled by the normal length otherwise. */
+	FORCEINLINE float PlaneDot(const FVector& point) const
+	{
+		return X * point.X + Y * point.Y + Z * point.Z + W;
+	}
+
+	FORCEINLINE FVector GetNormal() const
+	{
+		return FVector(X, Y, Z);
+	}
+
+	FORCEINLINE FPlane GetNormalized() const
+	{
+		const float invLength = 1.f / FMath::Sqrt(X * X + Y * Y + Z * Z);
+		return FPlane(X * invLength, Y * invLength, Z * invLength, W * invLength);
+	}
+
+	FORCEINLINE void Normalize()
+	{
+		*this = GetNormalized();
+	}
+
+public:
+
+	union
+	{
+		struct
+		{
+			float X, Y, Z, W;
+		};
+
+		float Components[4];
+	};
+};
+
+template<> struct TIsTriviallyRelocatable<FPlane> : FTrueType { };
+template<> struct TIsZeroConstructType<FPlane> : FTrueType { };
+template<> struct TIsPODType<FPlane> : FTrueType { };
+template<> struct TIsBitwiseComparable<FPlane> : FTrueType { };
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector.h"
+#include "Math/Quat.h"
+#include "Math/Box.h"
+
+#include <string.h>
+
+/**
+ * Compact encodings of vectors, rotations and normals, for data kept resident in bulk such as animation
+ * tracks, vertex streams and snapshots. Each type encodes on construction and decodes on demand; the
+ * EncodeArray and DecodeArray functions convert whole arrays with SIMD. The errors given are bounds on
+ * the difference between a decoded value and the value that was encoded.
+ */
+
+namespace Private
+{
+	FORCEINLINE u32 FloatAsBits(float value)
+	{
+		u32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	FORCEINLINE float FloatFromBits(u32 bits)
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	/** Rounds to the nearest half, ties to even, as the hardware conversions do. */
+	FORCEINLINE u16 FloatToHalf(float value)
+	{
+		const u32 sign = FloatAsBits(value) & 0x80000000u;
+		u32 bits = FloatAsBits(value) ^ sign;
+		u32 result;
+
+		if (bits >= 0x47800000u)
+		{
+			// 2^16 and up overflow to infinity, NaNs stay NaNs.
+			result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+		}
+		else if (bits < 0x38800000u)
+		{
+			// Below 2^-14 the result is subnormal: adding 0.5 aligns the 10 mantissa bits at the bottom of
+			// the float, the addition doing the rounding.
+			result = FloatAsBits(FloatFromBits(bits) + 0.5f) - 0x3F000000u;
+		}
+		else
+		{
+			// Rebias the exponent and round the 13 dropped mantissa bits to nearest even.
+			const u32 mantissaOdd = (bits >> 13) & 1;
+			bits += 0xC8000FFFu + mantissaOdd;
+			result = bits >> 13;
+		}
+
+		return (u16)(result | (sign >> 16));
+	}
+
+	FORCEINLINE float HalfToFloat(u16 half)
+	{
+		const u32 exponentMask = 0x7C00u << 13;
+		u32 bits = (half & 0x7FFFu) << 13;
+		const u32 exponent = bits & exponentMask;
+
+		bits += (127 - 15) << 23;
+		if (exponent == exponentMask)
+		{
+			// Infinity or NaN, the exponent is all ones again.
+			bits += (128 - 16) << 23;
+		}
+		else if (exponent == 0)
+		{
+			// Zero or subnormal, renormalized by the float unit.
+			bits = FloatAsBits(FloatFromBits(bits + (1 << 23)) - 6.103515625e-05f);
+		}
+
+		return FloatFromBits(bits | ((u32)(half & 0x8000u) << 16));
+	}
+
+	/**
+	 * Smallest three quaternion encoding: the largest component is dropped and rebuilt from the unit
+	 * length, leaving three components within +-1/sqrt(2) to quantize on ComponentBits each.
+	 */
+	template<i32 ComponentBits>
+	struct TSmallestThree
+	{
+		static constexpr u32 MaxValue = (1u << ComponentBits) - 1;
+		static constexpr float Range = 0.707106781f;
+		static constexpr float Scale = MaxValue * 0.5f / Range;
+		static constexpr float InvScale = Range * 2.0f / MaxValue;
+
+		/** Writes the index of the largest component and the quantized others, flipped so it is positive. */
+		FORCEINLINE static void Encode(const FQuat& q, u32& outLargest, u32 (&outSmallest)[3])
+		{
+			u32 largest = 0;
+			for (u32 i = 1; i < 4; ++i)
+			{
+				largest = FMath::Abs(q.Components[i]) > FMath::Abs(q.Components[largest]) ? i : largest;
+			}
+
+			const float sign = q.Components[largest] < 0.0f ? -1.0f : 1.0f;
+			for (u32 i = 0, j = 0; i < 4; ++i)
+			{
+				if (i != largest)
+				{
+					const float quantized = FMath::Clamp(q.Components[i] * sign * Scale + MaxValue * 0.5f, 0.0f, (float)MaxValue);
+					outSmallest[j++] = (u32)FMath::Round(quantized);
+				}
+			}
+			outLargest = largest;
+		}
+
+		FORCEINLINE static FQuat Decode(u32 largest, const u32 (&smallest)[3])
+		{
+			FQuat q;
+			float squaredSum = 0.0f;
+			for (u32 i = 0, j = 0; i < 4; ++i)
+			{
+				if (i != largest)
+				{
+					const float component = smallest[j++] * InvScale - Range;
+					q.Components[i] = component;
+					squaredSum += component * component;
+				}
+			}
+			q.Components[largest] = FMath::Sqrt(FMath::Max(1.0f - squaredSum, 0.0f));
+			return q;
+		}
+	};
+}
+
+/** IEEE 754 half precision float: 11 significant bits, finite up to 65504, relative error 2^-11 from 6.1e-5 on. */
+struct FFloat16
+{
+public:
+
+	FORCEINLINE FFloat16() : Encoded(0) {}
+	FORCEINLINE explicit FFloat16(float value) : Encoded(Private::FloatToHalf(value)) {}
+
+public:
+
+	FORCEINLINE float GetFloat() const { return Private::HalfToFloat(Encoded); }
+
+public:
+
+	/** Converts with F16C when the processor has it, rounding like the constructor. */
+	static void EncodeArray(const float* source, FFloat16* dest, i32 count);
+	static void DecodeArray(const FFloat16* source, float* dest, i32 count);
+
+public:
+
+	u16 Encoded;
+};
+
+template<> struct TIsTriviallyRelocatable<FFloat16> : FTrueType { };
+template<> struct TIsZeroConstructType<FFloat16> : FTrueType { };
+template<> struct TIsPODType<FFloat16> : FTrueType { };
+template<> struct TIsBitwiseComparable<FFloat16> : FTrueType { };
+
+/** FVector in half precision, 6 bytes, with the error of FFloat16 on each component. */
+struct FHalfVector
+{
+public:
+
+	FORCEINLINE FHalfVector() {}
+	FORCEINLINE explicit FHalfVector(const FVector& v) : X(v.X), Y(v.Y), Z(v.Z) {}
+
+public:
+
+	FORCEINLINE FVector ToVector() const { return FVector(X.GetFloat(), Y.GetFloat(), Z.GetFloat()); }
+
+public:
+
+	static void EncodeArray(const FVector* source, FHalfVector* dest, i32 count);
+	static void DecodeArray(const FHalfVector* source, FVector* dest, i32 count);
+
+public:
+
+	FFloat16 X, Y, Z;
+};
+
+template<> struct TIsTriviallyRelocatable<FHalfVector> : FTrueType { };
+template<> struct TIsZeroConstructType<FHalfVector> : FTrueType { };
+template<> struct TIsPODType<FHalfVector> : FTrueType { };
+template<> struct TIsBitwiseComparable<FHalfVector> : FTrueType { };
+
+/**
+ * Unit FQuat in 32 bits, smallest three on 10 bits each. Decodes to a unit quaternion, the same rotation
+ * as the encoded one within 0.004 rad, possibly negated.
+ */
+struct FQuantizedQuat32
+{
+public:
+
+	static constexpr i32 ComponentBits = 10;
+
+public:
+
+	FORCEINLINE FQuantizedQuat32() : Bits(0) {}
+
+	FORCEINLINE explicit FQuantizedQuat32(const FQuat& q)
+	{
+		u32 largest, smallest[3];
+		Private::TSmallestThree<ComponentBits>::Encode(q, largest, smallest);
+		Pack(largest, smallest);
+	}
+
+public:
+
+	FORCEINLINE FQuat ToQuat() const
+	{
+		u32 largest, smallest[3];
+		Unpack(largest, smallest);
+		return Private::TSmallestThree<ComponentBits>::Decode(largest, smallest);
+	}
+
+	FORCEINLINE void Pack(u32 largest, const u32 (&smallest)[3])
+	{
+		Bits = (largest << 30) | (smallest[0] << 20) | (smallest[1] << 10) | smallest[2];
+	}
+
+	FORCEINLINE void Unpack(u32& outLargest, u32 (&outSmallest)[3]) const
+	{
+		outLargest = Bits >> 30;
+		outSmallest[0] = (Bits >> 20) & 0x3FF;
+		outSmallest[1] = (Bits >> 10) & 0x3FF;
+		outSmallest[2] = Bits & 0x3FF;
+	}
+
+public:
+
+	static void EncodeArray(const FQuat* source, FQuantizedQuat32* dest, i32 count);
+	static void DecodeArray(const FQuantizedQuat32* source, FQuat* dest, i32 count);
+
+public:
+
+	u32 Bits;
+};
+
+template<> struct TIsTriviallyRelocatable<FQuantizedQuat32> : FTrueType { };
+template<> struct TIsZeroConstructType<FQuantizedQuat32> : FTrueType { };
+template<> struct TIsPODType<FQuantizedQuat32> : FTrueType { };
+template<> struct TIsBitwiseComparable<FQuantizedQuat32> : FTrueType { };
+
+/**
+ * Unit FQuat in 48 bits, smallest three on 15 bits each. Decodes to a unit quaternion, the same rotation
+ * as the encoded one within 1.4e-4 rad, possibly negated.
+ */
+struct FQuantizedQuat48
+{
+public:
+
+	static constexpr i32 ComponentBits = 15;
+
+public:
+
+	FORCEINLINE FQuantizedQuat48() : Bits{} {}
+
+	FORCEINLINE explicit FQuantizedQuat48(const FQuat& q)
+	{
+		u32 largest, smallest[3];
+		Private::TSmallestThree<ComponentBits>::Encode(q, largest, smallest);
+		Pack(largest, smallest);
+	}
+
+public:
+
+	FORCEINLINE FQuat ToQuat() const
+	{
+		u32 largest, smallest[3];
+		Unpack(largest, smallest);
+		return Private::TSmallestThree<ComponentBits>::Decode(largest, smallest);
+	}
+
+	// The index of the largest component goes in the top bits of the first two words.
+	FORCEINLINE void Pack(u32 largest, const u32 (&smallest)[3])
+	{
+		Bits[0] = (u16)(smallest[0] | ((largest & 1) << 15));
+		Bits[1] = (u16)(smallest[1] | ((largest >> 1) << 15));
+		Bits[2] = (u16)smallest[2];
+	}
+
+	FORCEINLINE void Unpack(u32& outLargest, u32 (&outSmallest)[3]) const
+	{
+		outLargest = (Bits[0] >> 15) | ((Bits[1] >> 15) << 1);
+		outSmallest[0] = Bits[0] & 0x7FFF;
+		outSmallest[1] = Bits[1] & 0x7FFF;
+		outSmallest[2] = Bits[2] & 0x7FFF;
+	}
+
+public:
+
+	static void EncodeArray(const FQuat* source, FQuantizedQuat48* dest, i32 count);
+	static void DecodeArray(const FQuantizedQuat48* source, FQuat* dest, i32 count);
+
+public:
+
+	u16 Bits[3];
+};
+
+template<> struct TIsTriviallyRelocatable<FQuantizedQuat48> : FTrueType { };
+template<> struct TIsZeroConstructType<FQuantizedQuat48> : FTrueType { };
+template<> struct TIsPODType<FQuantizedQuat48> : FTrueType { };
+template<> struct TIsBitwiseComparable<FQuantizedQuat48> : FTrueType { };
+
+/**
+ * Unit normal in 32 bits, octahedral mapping on two 16 bit snorms. The normal is projected on the octahedron
+ * |x| + |y| + |z| = 1 whose lower half is folded over the upper one, which spreads the precision evenly over
+ * the sphere. Decodes to a unit vector within 7e-5 rad of the encoded direction; the zero vector can't be
+ * encoded.
+ */
+struct FOctahedralNormal
+{
+public:
+
+	static constexpr float MaxValue = 32767.0f;
+
+public:
+
+	FORCEINLINE FOctahedralNormal() : X(0), Y(0) {}
+
+	FORCEINLINE explicit FOctahedralNormal(const FVector& normal)
+	{
+		const float invLength = 1.0f / (FMath::Abs(normal.X) + FMath::Abs(normal.Y) + FMath::Abs(normal.Z));
+		float x = normal.X * invLength;
+		float y = normal.Y * invLength;
+
+		if (normal.Z < 0.0f)
+		{
+			const float foldedX = (1.0f - FMath::Abs(y)) * (x < 0.0f ? -1.0f : 1.0f);
+			y = (1.0f - FMath::Abs(x)) * (y < 0.0f ? -1.0f : 1.0f);
+			x = foldedX;
+		}
+
+		X = (i16)FMath::Round(x * MaxValue);
+		Y = (i16)FMath::Round(y * MaxValue);
+	}
+
+public:
+
+	FVector ToVector() const;
+
+public:
+
+	static void EncodeArray(const FVector* source, FOctahedralNormal* dest, i32 count);
+	static void DecodeArray(const FOctahedralNormal* source, FVector* dest, i32 count);
+
+public:
+
+	i16 X, Y;
+};
+
+template<> struct TIsTriviallyRelocatable<FOctahedralNormal> : FTrueType { };
+template<> struct TIsZeroConstructType<FOctahedralNormal> : FTrueType { };
+template<> struct TIsPODType<FOctahedralNormal> : FTrueType { };
+template<> struct TIsBitwiseComparable<FOctahedralNormal> : FTrueType { };
+
+namespace Private
+{
+	/** Decodes four octahedral normals from their quantized components. ToVector and DecodeArray share it. */
+	FORCEINLINE void VectorDecodeOctahedral(VectorRegister quantizedX, VectorRegister quantizedY, VectorRegister& outX, VectorRegister& outY, VectorRegister& outZ)
+	{
+		const VectorRegister signBit = VectorSetFloat1(-0.0f);
+		const VectorRegister invMaxValue = VectorSetFloat1(1.0f / FOctahedralNormal::MaxValue);
+		const VectorRegister minusOne = VectorSetFloat1(-1.0f);
+
+		VectorRegister x = VectorMax(VectorMultiply(quantizedX, invMaxValue), minusOne);
+		VectorRegister y = VectorMax(VectorMultiply(quantizedY, invMaxValue), minusOne);
+		const VectorRegister z = VectorSubtract(VectorSubtract(VectorOne(), VectorAbs(x)), VectorAbs(y));
+
+		// Unfolds the lower half, moving x and y towards zero by max(-z, 0).
+		const VectorRegister t = VectorMax(VectorNegate(z), VectorZero());
+		x = VectorSubtract(x, VectorBitwiseOr(t, VectorBitwiseAnd(x, signBit)));
+		y = VectorSubtract(y, VectorBitwiseOr(t, VectorBitwiseAnd(y, signBit)));
+
+		const VectorRegister squaredLength = VectorMultiplyAdd(z, z, VectorMultiplyAdd(y, y, VectorMultiply(x, x)));
+		const VectorRegister invLength = VectorReciprocalSqrt(squaredLength);
+		outX = VectorMultiply(x, invLength);
+		outY = VectorMultiply(y, invLength);
+		outZ = VectorMultiply(z, invLength);
+	}
+}
+
+FORCEINLINE FVector FOctahedralNormal::ToVector() const
+{
+	VectorRegister x, y, z;
+	Private::VectorDecodeOctahedral(VectorSetFloat1((float)X), VectorSetFloat1((float)Y), x, y, z);
+	return FVector(VectorGetComponent<0>(x), VectorGetComponent<0>(y), VectorGetComponent<0>(z));
+}
+
+/**
+ * FVector quantized on 16 bits per component within a box known to the user, e.g. the bounds of a mesh or of
+ * an animation track. Components are clamped to the box and decode within half a step, 1/131070 of the box
+ * size on that axis, plus the float rounding of the box coordinates.
+ */
+struct FQuantizedVector
+{
+public:
+
+	static constexpr float MaxValue = 65535.0f;
+
+public:
+
+	FORCEINLINE FQuantizedVector() : X(0), Y(0), Z(0) {}
+
+	FORCEINLINE FQuantizedVector(const FVector& v, const FBox& bounds)
+	{
+		const FVector size = bounds.GetSize();
+		X = Quantize(v.X - bounds.Min.X, size.X);
+		Y = Quantize(v.Y - bounds.Min.Y, size.Y);
+		Z = Quantize(v.Z - bounds.Min.Z, size.Z);
+	}
+
+public:
+
+	FORCEINLINE FVector ToVector(const FBox& bounds) const
+	{
+		const FVector step = bounds.GetSize() * (1.0f / MaxValue);
+		return FVector(X * step.X + bounds.Min.X, Y * step.Y + bounds.Min.Y, Z * step.Z + bounds.Min.Z);
+	}
+
+public:
+
+	static void EncodeArray(const FVector* source, FQuantizedVector* dest, i32 count, const FBox& bounds);
+	static void DecodeArray(const FQuantizedVector* source, FVector* dest, i32 count, const FBox& bounds);
+
+private:
+
+	FORCEINLINE static u16 Quantize(float offset, float size)
+	{
+		const float scale = size > 0.0f ? MaxValue / size : 0.0f;
+		return (u16)FMath::Round(FMath::Clamp(offset * scale, 0.0f, MaxValue));
+	}
+
+public:
+
+	u16 X, Y, Z;
+};
+
+template<> struct TIsTriviallyRelocatable<FQuantizedVector> : FTrueType { };
+template<> struct TIsZeroConstructType<FQuantizedVector> : FTrueType { };
+template<> struct TIsPODType<FQuantizedVector> : FTrueType { };
+template<> struct TIsBitwiseComparable<FQuantizedVector> : FTrueType { };
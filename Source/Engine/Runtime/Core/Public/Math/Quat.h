@@ -12,8 +12,8 @@ public:
 
 public:
 
-	FORCEINLINE FQuat() : X(0.f), Y(0.f), Z(0.f), W(1.f) {}
-	FORCEINLINE FQuat(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+	FORCEINLINE CONSTEXPR FQuat() : X(0.f), Y(0.f), Z(0.f), W(1.f) {}
+	FORCEINLINE CONSTEXPR FQuat(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
 	FORCEINLINE FQuat(const FVector& axis, float angleRad)
 	{
 		const float halfAngle = angleRad * 0.5f;
@@ -169,6 +169,24 @@ public:
 		*this = GetNormalized();
 	}
 
+public:
+
+	// Pose blending over arrays of bones, vectorized across four bones at a time. dest may be the same array
+	// as either input. Each bone blends by alpha times its entry in boneWeights, or by alpha alone when
+	// boneWeights is null, so a zero weight masks the bone out. Blends take the shortest path.
+
+	/**
+	 * Normalized lerp. Deviates from the exact Slerp by at most 2.2e-5 rad for rotations within 10 degrees of
+	 * each other, 0.016 rad at 90 degrees and 0.14 rad at 180 degrees.
+	 */
+	static void NLerpArray(const FQuat* a, const FQuat* b, FQuat* dest, i32 count, float alpha, const float* boneWeights = nullptr);
+
+	/** Spherical lerp. Blocks of bones all within 2 degrees of their target use NLerp, within 2e-7 rad of Slerp there. */
+	static void SlerpArray(const FQuat* a, const FQuat* b, FQuat* dest, i32 count, float alpha, const float* boneWeights = nullptr);
+
+	/** Applies additive rotations on top of base, dest = NLerp(Identity, additive, weight) * base. */
+	static void ApplyAdditiveArray(const FQuat* base, const FQuat* additive, FQuat* dest, i32 count, float alpha, const float* boneWeights = nullptr);
+
 public:
 
 	union
@@ -180,4 +198,11 @@ public:
 
 		float Components[4];
 	};
-};
\ No newline at end of file
+};
+
+inline constexpr FQuat FQuat::Identity(0.0f, 0.0f, 0.0f, 1.0f);
+
+// Default constructs to the identity, so it isn't zero constructible.
+template<> struct TIsTriviallyRelocatable<FQuat> : FTrueType { };
+template<> struct TIsPODType<FQuat> : FTrueType { };
+template<> struct TIsBitwiseComparable<FQuat> : FTrueType { };
\ No newline at end of file
@@ -12,7 +12,8 @@ public:
 	FORCEINLINE FRect(float x, float y, const FVector2& size) : X(x), Y(y), Width(size.X), Height(size.Y) {}
 	FORCEINLINE FRect(const FVector2& position, float width, float height) : X(position.X), Y(position.Y), Width(width), Height(height) {}
 	FORCEINLINE FRect(const FVector2& position, const FVector2& size) : X(position.X), Y(position.Y), Width(size.X), Height(size.Y) {}
-	FORCEINLINE FRect(const FRect& r) : X(r.X), Y(r.Y), Width(r.Width), Height(r.Height) {}
+	FRect(const FRect&) = default;
+	FRect& operator=(const FRect&) = default;
 
 public:
 
@@ -94,6 +95,28 @@ public:
 		Height = max.Y - Y;
 	}
 
+	FORCEINLINE FVector2 GetPosition() const
+	{
+		return FVector2(X, Y);
+	}
+
+	FORCEINLINE FVector2 GetSize() const
+	{
+		return FVector2(Width, Height);
+	}
+
+	FORCEINLINE void SetPosition(const FVector2& position)
+	{
+		X = position.X;
+		Y = position.Y;
+	}
+
+	FORCEINLINE void SetSize(const FVector2& size)
+	{
+		Width = size.X;
+		Height = size.Y;
+	}
+
 	FORCEINLINE FVector2 GetCenter() const
 	{
 		return FVector2(X + Width * 0.5f, Y + Height * 0.5f);
@@ -125,12 +148,6 @@ public:
 			float X, Y, Width, Height;
 		};
 
-		struct
-		{
-			FVector2 Position;
-			FVector2 Size;
-		};
-
 		float Components[4];
 	};
 };
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector2.h"
+#include "Math/Rect.h"
+#include "Math/VectorRegister.h"
+#include "Containers/Array.h"
+
+/**
+ * Dynamic bounding volume tree over 2D rects, for overlap, point and ray queries that would otherwise scan
+ * every rect. Each proxy is stored with a rect fattened by a margin, so objects moving within it don't touch
+ * the tree; queries report proxies by their fattened rects and callers refine the hits if they need to.
+ * The tree is kept balanced by rotations as proxies come and go. Queries don't allocate.
+ */
+class FRectTree
+{
+public:
+
+	static constexpr i32 NullNode = -1;
+	static constexpr float DefaultMargin = 0.1f;
+
+public:
+
+	explicit FRectTree(float margin = DefaultMargin);
+
+public:
+
+	/** Adds a proxy for rect and returns its id, valid until it is destroyed. */
+	i32 CreateProxy(const FRect& rect, void* userData);
+	void DestroyProxy(i32 proxyId);
+
+	/**
+	 * Updates the rect of a proxy, reinserting it only when it left its fattened rect. The new fattened rect
+	 * is also stretched by displacement, the expected motion until the next move. Returns whether the proxy
+	 * was reinserted.
+	 */
+	bool MoveProxy(i32 proxyId, const FRect& rect, const FVector2& displacement);
+
+	FORCEINLINE void* GetUserData(i32 proxyId) const
+	{
+		CHECK(m_Nodes.IsValidIndex(proxyId) && m_Nodes[proxyId].IsLeaf());
+		return m_Nodes[proxyId].UserData;
+	}
+
+	FORCEINLINE FRect GetFatRect(i32 proxyId) const
+	{
+		CHECK(m_Nodes.IsValidIndex(proxyId) && m_Nodes[proxyId].IsLeaf());
+		const float* bounds = m_Nodes[proxyId].Bounds;
+		return FRect(bounds[0], bounds[1], -bounds[2] - bounds[0], -bounds[3] - bounds[1]);
+	}
+
+	FORCEINLINE i32 GetNumProxies() const { return m_NumProxies; }
+
+	/** Height of the tree, 0 with a single proxy. */
+	FORCEINLINE i32 GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+public:
+
+	/** Calls callback(proxyId) for the proxies overlapping rect, until it returns false. */
+	template<typename FunctionType>
+	void QueryOverlaps(const FRect& rect, FunctionType&& callback) const
+	{
+		Query(VectorSet(rect.X + rect.Width, rect.Y + rect.Height, -rect.X, -rect.Y), callback);
+	}
+
+	/** Calls callback(proxyId) for the proxies containing point, until it returns false. */
+	template<typename FunctionType>
+	void QueryPoint(const FVector2& point, FunctionType&& callback) const
+	{
+		Query(VectorSet(point.X, point.Y, -point.X, -point.Y), callback);
+	}
+
+	/**
+	 * Walks the proxies crossed by the segment origin + t * direction, t in [0, maxFraction], calling
+	 * callback(proxyId, maxFraction). The callback returns the fraction to clip the segment at: that of its
+	 * own hit, maxFraction to go on unchanged, or 0 to stop.
+	 */
+	template<typename FunctionType>
+	void RayCast(const FVector2& origin, const FVector2& direction, float maxFraction, FunctionType&& callback) const
+	{
+		if (m_Root == NullNode)
+		{
+			return;
+		}
+
+		// Slab test on (MinX, MinY, MaxX, MaxY) at once. Axis parallel rays divide by zero and get infinities,
+		// which the comparisons handle, except for an origin exactly on an edge where 0 * infinity gives NaN.
+		// Such edges count as inside, as in the other queries: the ray then stays within that slab for any t.
+		const VectorRegister boundsSign = VectorSet(1.0f, 1.0f, -1.0f, -1.0f);
+		const VectorRegister infinity = VectorSetFloat1(INFINITY);
+		const VectorRegister origins = VectorSet(origin.X, origin.Y, origin.X, origin.Y);
+		const VectorRegister invDirections = VectorDivide(VectorOne(), VectorSet(direction.X, direction.Y, direction.X, direction.Y));
+
+		i32 stack[MaxStackSize];
+		i32 stackSize = 0;
+		stack[stackSize++] = m_Root;
+
+		while (stackSize > 0)
+		{
+			const i32 index = stack[--stackSize];
+			const FNode& node = m_Nodes[index];
+
+			const VectorRegister t = VectorMultiply(VectorSubtract(VectorMultiply(VectorLoadAligned(node.Bounds), boundsSign), origins), invDirections);
+			const VectorRegister bNaN = VectorCompareNE(t, t);
+			const VectorRegister bOnEdge = VectorBitwiseOr(bNaN, VectorSwizzle<2, 3, 0, 1>(bNaN));
+			const VectorRegister tNear = VectorSelect(bOnEdge, VectorNegate(infinity), VectorMin(t, VectorSwizzle<2, 3, 0, 1>(t)));
+			const VectorRegister tFar = VectorSelect(bOnEdge, infinity, VectorMax(t, VectorSwizzle<2, 3, 0, 1>(t)));
+			const float enter = FMath::Max(FMath::Max(VectorGetComponent<0>(tNear), VectorGetComponent<1>(tNear)), 0.0f);
+			const float exit = FMath::Min(FMath::Min(VectorGetComponent<0>(tFar), VectorGetComponent<1>(tFar)), maxFraction);
+
+			if (!(enter <= exit))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				maxFraction = callback(index, maxFraction);
+				if (maxFraction <= 0.0f)
+				{
+					return;
+				}
+			}
+			else
+			{
+				CHECK(stackSize + 2 <= MaxStackSize);
+				stack[stackSize++] = node.Child1;
+				stack[stackSize++] = node.Child2;
+			}
+		}
+	}
+
+private:
+
+	// Deep enough for any tree the rotations keep balanced.
+	static constexpr i32 MaxStackSize = 256;
+
+	/**
+	 * Bounds are held as (MinX, MinY, -MaxX, -MaxY): the union of two is their component wise minimum, and
+	 * a rect overlaps a query (MaxX, MaxY, -MinX, -MinY) when all four components compare less or equal.
+	 */
+	struct MS_ALIGN(16) FNode
+	{
+		float Bounds[4];
+		void* UserData;
+
+		// Free nodes link through Next.
+		union
+		{
+			i32 Parent;
+			i32 Next;
+		};
+
+		i32 Child1;
+		i32 Child2;
+
+		// 0 for leaves, -1 for free nodes.
+		i32 Height;
+
+		FORCEINLINE bool IsLeaf() const { return Child1 == NullNode; }
+	} GCC_ALIGN(16);
+
+	template<typename FunctionType>
+	void Query(VectorRegister query, FunctionType& callback) const
+	{
+		if (m_Root == NullNode)
+		{
+			return;
+		}
+
+		i32 stack[MaxStackSize];
+		i32 stackSize = 0;
+		stack[stackSize++] = m_Root;
+
+		while (stackSize > 0)
+		{
+			const i32 index = stack[--stackSize];
+			const FNode& node = m_Nodes[index];
+
+			if (VectorMaskBits(VectorCompareLE(VectorLoadAligned(node.Bounds), query)) != 0xF)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				if (!callback(index))
+				{
+					return;
+				}
+			}
+			else
+			{
+				CHECK(stackSize + 2 <= MaxStackSize);
+				stack[stackSize++] = node.Child1;
+				stack[stackSize++] = node.Child2;
+			}
+		}
+	}
+
+	i32 AllocateNode();
+	void FreeNode(i32 index);
+
+	void InsertLeaf(i32 leaf);
+	void RemoveLeaf(i32 leaf);
+
+	/** Rotates the subtree at index when its children heights differ by more than one, returns its new root. */
+	i32 Balance(i32 index);
+
+	/** Recomputes the bounds and height of the ancestors of index, balancing them on the way up. */
+	void Refit(i32 index);
+
+private:
+
+	TArray<FNode> m_Nodes;
+	i32 m_Root;
+	i32 m_FreeList;
+	i32 m_NumProxies;
+	float m_Margin;
+};
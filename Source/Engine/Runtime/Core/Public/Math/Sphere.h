@@ -0,0 +1,58 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/Vector.h"
+
+struct FSphere
+{
+public:
+
+	FORCEINLINE FSphere() : Center(0.f), Radius(0.f) {}
+	FORCEINLINE FSphere(const FVector& center, float radius) : Center(center), Radius(radius) {}
+
+public:
+
+	FORCEINLINE bool Contains(const FVector& point) const
+	{
+		return (point - Center).GetSquaredLength() <= Radius * Radius;
+	}
+
+	FORCEINLINE bool Intersects(const FSphere& other) const
+	{
+		const float radii = Radius + other.Radius;
+		return (other.Center - Center).GetSquaredLength() <= radii * radii;
+	}
+
+	/** Grows the sphere to also hold other, keeping it as small as possible. */
+	FORCEINLINE void Encapsulate(const FSphere& other)
+	{
+		const FVector delta = other.Center - Center;
+		const float distance = delta.GetLength();
+
+		if (distance + other.Radius <= Radius)
+		{
+			return;
+		}
+
+		if (distance + Radius <= other.Radius)
+		{
+			*this = other;
+			return;
+		}
+
+		const float radius = (distance + Radius + other.Radius) * 0.5f;
+		Center += delta * ((radius - Radius) / distance);
+		Radius = radius;
+	}
+
+public:
+
+	FVector Center;
+	float Radius;
+};
+
+template<> struct TIsTriviallyRelocatable<FSphere> : FTrueType { };
+template<> struct TIsZeroConstructType<FSphere> : FTrueType { };
+template<> struct TIsPODType<FSphere> : FTrueType { };
+template<> struct TIsBitwiseComparable<FSphere> : FTrueType { };
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Math.h"
+#include "Math/VectorRegister.h"
+#include "Math/Vector.h"
+#include "Math/Vector4.h"
+#include "Math/Quat.h"
+#include "Math/Matrix.h"
+
+/**
+ * Translation, rotation and scale, applied to points in reverse order: scale first, then rotation, then
+ * translation, like FMatrix::TRS. Composition and transforms work on the components directly, so a matrix
+ * is only needed at the point one is handed to something that wants it, through ToMatrix.
+ * The rotation is expected to be normalized.
+ */
+struct MS_ALIGN(16) FTransform
+{
+public:
+
+	static const FTransform Identity;
+
+public:
+
+	FORCEINLINE FTransform()
+		: m_Rotation(VectorSet(0.0f, 0.0f, 0.0f, 1.0f))
+		, m_Translation(VectorZero())
+		, m_Scale(VectorSet(1.0f, 1.0f, 1.0f, 0.0f))
+	{
+	}
+
+	FORCEINLINE FTransform(const FVector& translation, const FQuat& rotation, const FVector& scale)
+		: m_Rotation(VectorLoad(rotation.Components))
+		, m_Translation(LoadVector(translation))
+		, m_Scale(LoadVector(scale))
+	{
+	}
+
+	FORCEINLINE FTransform(const FVector& translation, const FQuat& rotation)
+		: m_Rotation(VectorLoad(rotation.Components))
+		, m_Translation(LoadVector(translation))
+		, m_Scale(VectorSet(1.0f, 1.0f, 1.0f, 0.0f))
+	{
+	}
+
+	FORCEINLINE explicit FTransform(const FQuat& rotation)
+		: m_Rotation(VectorLoad(rotation.Components))
+		, m_Translation(VectorZero())
+		, m_Scale(VectorSet(1.0f, 1.0f, 1.0f, 0.0f))
+	{
+	}
+
+public:
+
+	/**
+	 * Returns the transform applying other first and this second, the same order as multiplying their
+	 * matrices. Exact when this has a uniform scale; a non uniform scale followed by a rotation would shear,
+	 * which a transform can't hold, so the scales are multiplied component wise instead.
+	 */
+	FORCEINLINE FTransform operator*(const FTransform& other) const
+	{
+		FTransform result;
+		result.m_Rotation = VectorQuaternionMultiply(m_Rotation, other.m_Rotation);
+		result.m_Translation = VectorAdd(VectorQuaternionRotateVector(m_Rotation, VectorMultiply(m_Scale, other.m_Translation)), m_Translation);
+		result.m_Scale = VectorMultiply(m_Scale, other.m_Scale);
+		return result;
+	}
+
+	FORCEINLINE FTransform& operator*=(const FTransform& other)
+	{
+		*this = *this * other;
+		return *this;
+	}
+
+public:
+
+	FORCEINLINE FVector TransformPoint(const FVector& point) const
+	{
+		return StoreVector(VectorAdd(VectorQuaternionRotateVector(m_Rotation, VectorMultiply(m_Scale, LoadVector(point))), m_Translation));
+	}
+
+	/** Applies the rotation and scale, not the translation. */
+	FORCEINLINE FVector TransformVector(const FVector& vector) const
+	{
+		return StoreVector(VectorQuaternionRotateVector(m_Rotation, VectorMultiply(m_Scale, LoadVector(vector))));
+	}
+
+	/** Exact inverse of TransformPoint, also with a non uniform scale. Zero scale components map to zero. */
+	FORCEINLINE FVector InverseTransformPoint(const FVector& point) const
+	{
+		const VectorRegister unrotated = VectorQuaternionRotateVector(VectorQuaternionConjugate(m_Rotation), VectorSubtract(LoadVector(point), m_Translation));
+		return StoreVector(VectorMultiply(unrotated, GetSafeScaleReciprocal()));
+	}
+
+	/** Exact inverse of TransformVector, also with a non uniform scale. Zero scale components map to zero. */
+	FORCEINLINE FVector InverseTransformVector(const FVector& vector) const
+	{
+		const VectorRegister unrotated = VectorQuaternionRotateVector(VectorQuaternionConjugate(m_Rotation), LoadVector(vector));
+		return StoreVector(VectorMultiply(unrotated, GetSafeScaleReciprocal()));
+	}
+
+	/**
+	 * Returns the transform undoing this one. Exact with a uniform scale, see operator*; use the
+	 * InverseTransform functions to undo a non uniform scale exactly.
+	 */
+	FORCEINLINE FTransform Inverse() const
+	{
+		FTransform result;
+		result.m_Rotation = VectorQuaternionConjugate(m_Rotation);
+		result.m_Scale = GetSafeScaleReciprocal();
+		result.m_Translation = VectorMultiply(VectorQuaternionRotateVector(result.m_Rotation, VectorNegate(m_Translation)), result.m_Scale);
+		return result;
+	}
+
+	/** Same matrix as FMatrix::TRS(GetTranslation(), GetRotation(), GetScale()), built without multiplications of matrices. */
+	FORCEINLINE FMatrix ToMatrix() const
+	{
+		const FQuat q = GetRotation();
+		const FVector t = GetTranslation();
+		const FVector s = GetScale();
+
+		const float x2 = q.X + q.X;
+		const float y2 = q.Y + q.Y;
+		const float z2 = q.Z + q.Z;
+
+		const float xx2 = q.X * x2;
+		const float yy2 = q.Y * y2;
+		const float zz2 = q.Z * z2;
+
+		const float xy2 = q.X * y2;
+		const float xz2 = q.X * z2;
+		const float yz2 = q.Y * z2;
+
+		const float wx2 = q.W * x2;
+		const float wy2 = q.W * y2;
+		const float wz2 = q.W * z2;
+
+		return FMatrix
+		(
+			FVector4((1.0f - yy2 - zz2) * s.X, (xy2 - wz2) * s.Y, (xz2 + wy2) * s.Z, t.X),
+			FVector4((xy2 + wz2) * s.X, (1.0f - xx2 - zz2) * s.Y, (yz2 - wx2) * s.Z, t.Y),
+			FVector4((xz2 - wy2) * s.X, (yz2 + wx2) * s.Y, (1.0f - xx2 - yy2) * s.Z, t.Z),
+			FVector4(0.0f, 0.0f, 0.0f, 1.0f)
+		);
+	}
+
+public:
+
+	/** Interpolates translation and scale linearly and the rotation along the shortest path, normalized. */
+	FORCEINLINE static FTransform Blend(const FTransform& a, const FTransform& b, float alpha)
+	{
+		const VectorRegister t = VectorSetFloat1(alpha);
+
+		// q and -q are the same rotation, pick the one on the same hemisphere as a.
+		const VectorRegister bFlip = VectorCompareLT(VectorDot4(a.m_Rotation, b.m_Rotation), VectorZero());
+		const VectorRegister rotationB = VectorSelect(bFlip, VectorNegate(b.m_Rotation), b.m_Rotation);
+		const VectorRegister rotation = VectorMultiplyAdd(VectorSubtract(rotationB, a.m_Rotation), t, a.m_Rotation);
+
+		FTransform result;
+		result.m_Rotation = VectorMultiply(rotation, VectorReciprocalSqrt(VectorDot4(rotation, rotation)));
+		result.m_Translation = VectorMultiplyAdd(VectorSubtract(b.m_Translation, a.m_Translation), t, a.m_Translation);
+		result.m_Scale = VectorMultiplyAdd(VectorSubtract(b.m_Scale, a.m_Scale), t, a.m_Scale);
+		return result;
+	}
+
+public:
+
+	FORCEINLINE FQuat GetRotation() const
+	{
+		FQuat rotation;
+		VectorStore(m_Rotation, rotation.Components);
+		return rotation;
+	}
+
+	FORCEINLINE FVector GetTranslation() const { return StoreVector(m_Translation); }
+	FORCEINLINE FVector GetScale() const { return StoreVector(m_Scale); }
+
+	FORCEINLINE void SetRotation(const FQuat& rotation) { m_Rotation = VectorLoad(rotation.Components); }
+	FORCEINLINE void SetTranslation(const FVector& translation) { m_Translation = LoadVector(translation); }
+	FORCEINLINE void SetScale(const FVector& scale) { m_Scale = LoadVector(scale); }
+
+private:
+
+	FORCEINLINE static VectorRegister LoadVector(const FVector& v)
+	{
+		return VectorSet(v.X, v.Y, v.Z, 0.0f);
+	}
+
+	FORCEINLINE static FVector StoreVector(VectorRegister v)
+	{
+		const FVector4 result(v);
+		return FVector(result.X, result.Y, result.Z);
+	}
+
+	FORCEINLINE VectorRegister GetSafeScaleReciprocal() const
+	{
+		const VectorRegister bZero = VectorCompareEQ(m_Scale, VectorZero());
+		return VectorSelect(bZero, VectorZero(), VectorDivide(VectorOne(), m_Scale));
+	}
+
+private:
+
+	// Translation and scale keep W at zero.
+	VectorRegister m_Rotation;
+	VectorRegister m_Translation;
+	VectorRegister m_Scale;
+} GCC_ALIGN(16);
+
+template<> struct TIsTriviallyRelocatable<FTransform> : FTrueType { };
+template<> struct TIsPODType<FTransform> : FTrueType { };
+template<> struct TIsBitwiseComparable<FTransform> : FTrueType { };
@@ -2,72 +2,7 @@
 
 #include "HAL/Platform.h"
 #include "Math/Math.h"
-
-// TODO: move to a file
-struct FColor32
-{
-public:
-
-	static const FColor32 Clear;
-	static const FColor32 Black;
-	static const FColor32 White;
-	static const FColor32 Red;
-	static const FColor32 Green;
-	static const FColor32 Blue;
-	static const FColor32 Yellow;
-	static const FColor32 Cyan;
-	static const FColor32 Magenta;
-	static const FColor32 Orange;
-	static const FColor32 Purple;
-	static const FColor32 Turquoise;
-	static const FColor32 Silver;
-	static const FColor32 Emerald;
-
-public:
-
-	FORCEINLINE FColor32() : UnsingnedIntValue(0) {}
-	FORCEINLINE FColor32(u8 r, u8 g, u8 b, u8 a = 255) : R(r), G(g), B(b), A(a) {}
-	FORCEINLINE FColor32(const FColor32& c) : UnsingnedIntValue(c.UnsingnedIntValue) {}
-
-	FORCEINLINE FColor32(const FColor32& c, u8 a) : UnsingnedIntValue(c.UnsingnedIntValue)
-	{
-		A = a;
-	}
-
-	FORCEINLINE FColor32(const FColor32& c, float a) : UnsingnedIntValue(c.UnsingnedIntValue)
-	{
-		A = (u8)(a * 255.f);
-	}
-
-public: 
-
-	FORCEINLINE const u8& operator[](const i32 index) const
-	{
-		CHECK(index >= 0 && index < 4);
-		return Components[index];
-	}
-
-	FORCEINLINE u8& operator[](const i32 index)
-	{
-		CHECK(index >= 0 && index < 4);
-		return Components[index];
-	}
-
-public:
-
-	union
-	{
-		u32 UnsingnedIntValue;
-		i32 SignedIntValue;
-
-		struct
-		{
-			u8 R, G, B, A;
-		};
-
-		u8 Components[4];
-	};
-};
+#include "Math/Color.h"
 
 struct FVector
 {
@@ -84,11 +19,12 @@ public:
 
 public:
 
-	FORCEINLINE FVector() : X(0.f), Y(0.f), Z(0.f) {}
-	FORCEINLINE FVector(float x, float y, float z) : X(x), Y(y), Z(z) {}
-	FORCEINLINE FVector(float x, float y) : X(x), Y(y), Z(0.f) {}
-	FORCEINLINE FVector(float x) : X(x), Y(x), Z(x) {}
-	FORCEINLINE FVector(const FVector& v) : X(v.X), Y(v.Y), Z(v.Z) {}
+	FORCEINLINE CONSTEXPR FVector() : X(0.f), Y(0.f), Z(0.f) {}
+	FORCEINLINE CONSTEXPR FVector(float x, float y, float z) : X(x), Y(y), Z(z) {}
+	FORCEINLINE CONSTEXPR FVector(float x, float y) : X(x), Y(y), Z(0.f) {}
+	FORCEINLINE CONSTEXPR FVector(float x) : X(x), Y(x), Z(x) {}
+	CONSTEXPR FVector(const FVector&) = default;
+	CONSTEXPR FVector& operator=(const FVector&) = default;
 
 public:
 
@@ -104,14 +40,14 @@ public:
 		return Components[index]; 
 	}
 
-	FORCEINLINE FVector operator+(const FVector& v) const { return FVector(X + v.X, Y + v.Y, Z + v.Z); }
-	FORCEINLINE FVector operator-(const FVector& v) const { return FVector(X - v.X, Y - v.Y, Z - v.Z); }
+	FORCEINLINE CONSTEXPR FVector operator+(const FVector& v) const { return FVector(X + v.X, Y + v.Y, Z + v.Z); }
+	FORCEINLINE CONSTEXPR FVector operator-(const FVector& v) const { return FVector(X - v.X, Y - v.Y, Z - v.Z); }
 
 	FORCEINLINE FVector& operator+=(const FVector& Other) { X += Other.X; Y += Other.Y; Z += Other.Z; return *this; }
 	FORCEINLINE FVector operator-=(const FVector& Other) { X -= Other.X; Y -= Other.Y; Z -= Other.Z; return *this; }
 
 	template<typename T>
-	FORCEINLINE FVector operator*(const T& s) const
+	FORCEINLINE CONSTEXPR FVector operator*(const T& s) const
 	{
 		static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 
@@ -129,12 +65,12 @@ public:
 
 public:
 
-	FORCEINLINE static float Dot(const FVector& v1, const FVector& v2)
+	FORCEINLINE CONSTEXPR static float Dot(const FVector& v1, const FVector& v2)
 	{
 		return v1.X * v2.X + v1.Y * v2.Y + v1.Z * v2.Z;
 	}
 
-	FORCEINLINE static FVector Cross(const FVector& v1, const FVector& v2)
+	FORCEINLINE CONSTEXPR static FVector Cross(const FVector& v1, const FVector& v2)
 	{
 		return FVector
 		(
@@ -209,6 +145,15 @@ public:
 		return v1 + delta.GetNormalized() * maxDelta;
 	}
 
+public:
+
+	// Pose blending over arrays of bones, see FQuat::NLerpArray for dest and the weights.
+
+	static void LerpArray(const FVector* a, const FVector* b, FVector* dest, i32 count, float alpha, const float* boneWeights = nullptr);
+
+	/** dest = base + additive * weight. */
+	static void ApplyAdditiveArray(const FVector* base, const FVector* additive, FVector* dest, i32 count, float alpha, const float* boneWeights = nullptr);
+
 public:
 
 	FORCEINLINE float GetLength() const { return FMath::Sqrt(X * X + Y * Y + Z * Z); }
@@ -229,8 +174,22 @@ public:
 	};
 };
 
+inline constexpr FVector FVector::Zero(0.0f, 0.0f, 0.0f);
+inline constexpr FVector FVector::One(1.0f, 1.0f, 1.0f);
+inline constexpr FVector FVector::Right(1.0f, 0.0f, 0.0f);
+inline constexpr FVector FVector::Left(-1.0f, 0.0f, 0.0f);
+inline constexpr FVector FVector::Up(0.0f, 1.0f, 0.0f);
+inline constexpr FVector FVector::Down(0.0f, -1.0f, 0.0f);
+inline constexpr FVector FVector::Forward(0.0f, 0.0f, 1.0f);
+inline constexpr FVector FVector::Back(0.0f, 0.0f, -1.0f);
+
+template<> struct TIsTriviallyRelocatable<FVector> : FTrueType { };
+template<> struct TIsZeroConstructType<FVector> : FTrueType { };
+template<> struct TIsPODType<FVector> : FTrueType { };
+template<> struct TIsBitwiseComparable<FVector> : FTrueType { };
+
 template<typename T>
-FORCEINLINE FVector operator*(const T& s, const FVector& v)
+FORCEINLINE CONSTEXPR FVector operator*(const T& s, const FVector& v)
 {
 	static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 
@@ -16,10 +16,11 @@ public:
 
 public:
 
-	FORCEINLINE FVector2() : X(0.0f), Y(0.0f) {}
-	FORCEINLINE FVector2(float x, float y) : X(x), Y(y) {}
-	FORCEINLINE FVector2(float x) : X(x), Y(x) {}
-	FORCEINLINE FVector2(const FVector2& v) : X(v.X), Y(v.Y) {}
+	FORCEINLINE CONSTEXPR FVector2() : X(0.0f), Y(0.0f) {}
+	FORCEINLINE CONSTEXPR FVector2(float x, float y) : X(x), Y(y) {}
+	FORCEINLINE CONSTEXPR FVector2(float x) : X(x), Y(x) {}
+	CONSTEXPR FVector2(const FVector2&) = default;
+	CONSTEXPR FVector2& operator=(const FVector2&) = default;
 
 public:
 
@@ -34,14 +35,14 @@ public:
 		return Components[index]; 
 	}
 
-	FORCEINLINE FVector2 operator+(const FVector2& v) const { return FVector2(X + v.X, Y + v.Y); }
-	FORCEINLINE FVector2 operator-(const FVector2& v) const { return FVector2(X - v.X, Y - v.Y); }
+	FORCEINLINE CONSTEXPR FVector2 operator+(const FVector2& v) const { return FVector2(X + v.X, Y + v.Y); }
+	FORCEINLINE CONSTEXPR FVector2 operator-(const FVector2& v) const { return FVector2(X - v.X, Y - v.Y); }
 
 	FORCEINLINE FVector2& operator+=(const FVector2& Other) { X += Other.X; Y += Other.Y; return *this; }
 	FORCEINLINE FVector2 operator-=(const FVector2& Other) { X -= Other.X; Y -= Other.Y; return *this; }
 
 	template<typename T>
-	FORCEINLINE FVector2 operator*(const T& s) const
+	FORCEINLINE CONSTEXPR FVector2 operator*(const T& s) const
 	{
 		static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 
@@ -59,7 +60,7 @@ public:
 
 public:
 
-	FORCEINLINE static float Dot(const FVector2& v1, const FVector2& v2)
+	FORCEINLINE CONSTEXPR static float Dot(const FVector2& v1, const FVector2& v2)
 	{
 		return v1.X * v2.X + v1.Y * v2.Y;
 	}
@@ -97,8 +98,15 @@ public:
 	};
 };
 
+inline constexpr FVector2 FVector2::Zero(0.0f, 0.0f);
+inline constexpr FVector2 FVector2::One(1.0f, 1.0f);
+inline constexpr FVector2 FVector2::Right(1.0f, 0.0f);
+inline constexpr FVector2 FVector2::Left(-1.0f, 0.0f);
+inline constexpr FVector2 FVector2::Up(0.0f, 1.0f);
+inline constexpr FVector2 FVector2::Down(0.0f, -1.0f);
+
 template<typename T>
-FORCEINLINE FVector2 operator*(const T& s, const FVector2& v)
+FORCEINLINE CONSTEXPR FVector2 operator*(const T& s, const FVector2& v)
 {
 	static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 
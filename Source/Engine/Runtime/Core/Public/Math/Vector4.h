@@ -2,6 +2,7 @@
 
 #include "HAL/Platform.h"
 #include "Math/Math.h"
+#include "Math/VectorRegister.h"
 
 struct FVector4
 {
@@ -12,9 +13,11 @@ public:
 
 public:
 
-	FORCEINLINE FVector4() : X(0), Y(0), Z(0), W(0) {}
-	FORCEINLINE FVector4(const float InX, const float InY, const float InZ, const float InW) : X(InX), Y(InY), Z(InZ), W(InW) {}
-	FORCEINLINE FVector4(const FVector4& Other) : X(Other.X), Y(Other.Y), Z(Other.Z), W(Other.W) {}
+	FORCEINLINE CONSTEXPR FVector4() : X(0), Y(0), Z(0), W(0) {}
+	FORCEINLINE CONSTEXPR FVector4(const float InX, const float InY, const float InZ, const float InW) : X(InX), Y(InY), Z(InZ), W(InW) {}
+	CONSTEXPR FVector4(const FVector4&) = default;
+	CONSTEXPR FVector4& operator=(const FVector4&) = default;
+	FORCEINLINE explicit FVector4(VectorRegister v) { VectorStore(v, Components); }
 
 public:
 
@@ -30,18 +33,18 @@ public:
 		return Components[index]; 
 	}
 
-	FORCEINLINE FVector4 operator+(const FVector4& Other) const { return FVector4(X + Other.X, Y + Other.Y, Z + Other.Z, W + Other.W); }
-	FORCEINLINE FVector4 operator-(const FVector4& Other) const { return FVector4(X - Other.X, Y - Other.Y, Z - Other.Z, W - Other.W); }
+	FORCEINLINE FVector4 operator+(const FVector4& Other) const { return FVector4(VectorAdd(ToRegister(), Other.ToRegister())); }
+	FORCEINLINE FVector4 operator-(const FVector4& Other) const { return FVector4(VectorSubtract(ToRegister(), Other.ToRegister())); }
 
-	FORCEINLINE FVector4& operator+=(const FVector4& Other) { X += Other.X; Y += Other.Y; Z += Other.Z; W += Other.W; return *this; }
-	FORCEINLINE FVector4& operator-=(const FVector4& Other) { X -= Other.X; Y -= Other.Y; Z -= Other.Z; W -= Other.W; return *this; }
+	FORCEINLINE FVector4& operator+=(const FVector4& Other) { VectorStore(VectorAdd(ToRegister(), Other.ToRegister()), Components); return *this; }
+	FORCEINLINE FVector4& operator-=(const FVector4& Other) { VectorStore(VectorSubtract(ToRegister(), Other.ToRegister()), Components); return *this; }
 
 	template<typename T>
 	FORCEINLINE FVector4 operator*(const T& s) const
 	{
 		static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 
-		return FVector4(X * s, Y * s, Z * s, W * s);
+		return FVector4(VectorMultiply(ToRegister(), VectorSetFloat1((float)s)));
 	}
 
 	template<typename T>
@@ -50,7 +53,14 @@ public:
 		static_assert(TIsArithmetic<T>::Value, "T must be a arithmetic type.");
 		
 		CHECK(s != 0);
-		return FVector4(X / s, Y / s, Z / s, W * s);
+		return FVector4(VectorDivide(ToRegister(), VectorSetFloat1((float)s)));
+	}
+
+public:
+
+	FORCEINLINE VectorRegister ToRegister() const
+	{
+		return VectorLoad(Components);
 	}
 
 public:
@@ -65,3 +75,11 @@ public:
 		float Components[4];
 	};
 };
+
+inline constexpr FVector4 FVector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+inline constexpr FVector4 FVector4::One(1.0f, 1.0f, 1.0f, 1.0f);
+
+template<> struct TIsTriviallyRelocatable<FVector4> : FTrueType { };
+template<> struct TIsZeroConstructType<FVector4> : FTrueType { };
+template<> struct TIsPODType<FVector4> : FTrueType { };
+template<> struct TIsBitwiseComparable<FVector4> : FTrueType { };
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/VectorRegister.h"
+
+#include <cmath>
+
+/**
+ * Transcendental functions on VectorRegister, built from the Cephes single precision polynomials with
+ * branches replaced by selects. The documented errors are the largest measured against the correctly
+ * rounded result, in units in the last place (ULP), over the stated domain. FMath forwards its scalar
+ * versions here, so both agree bit for bit.
+ */
+
+/**
+ * 1 / sqrt(v) as a correctly rounded square root followed by a division. Max error 1.5 ULP over all positive
+ * inputs, denormals included. An estimate with a Newton-Raphson step is about as fast for independent lanes, but
+ * reaches 4 ULP and depends on the hardware estimate; VectorReciprocalSqrtEstimate is there when 12 bits do.
+ */
+FORCEINLINE VectorRegister VectorReciprocalSqrt(VectorRegister v)
+{
+	return VectorDivide(VectorOne(), VectorSqrt(v));
+}
+
+/**
+ * Sine and cosine at once. Max error 2 ULP for |angle| <= pi; further out the reduction keeps the absolute
+ * error below 1e-7 up to |angle| <= 8192 and loses precision beyond.
+ */
+FORCEINLINE void VectorSinCos(VectorRegister angles, VectorRegister& outSin, VectorRegister& outCos)
+{
+	const VectorRegister signBit = VectorSetFloat1(-0.0f);
+	const VectorRegister x = VectorAbs(angles);
+
+	// Quadrant q closest to x, so the reduced angle r lies in [-pi/4, pi/4].
+	const VectorRegister q = VectorRound(VectorMultiply(x, VectorSetFloat1(0.636619772367581343f)));
+
+	// r = x - q * pi/2 with pi/2 split in three parts, the first two exact when multiplied by q.
+	VectorRegister r = VectorMultiplyAdd(q, VectorSetFloat1(-1.5703125f), x);
+	r = VectorMultiplyAdd(q, VectorSetFloat1(-4.837512969970703125e-4f), r);
+	r = VectorMultiplyAdd(q, VectorSetFloat1(-7.54978995489188216e-8f), r);
+
+	const VectorRegister z = VectorMultiply(r, r);
+
+	VectorRegister cosR = VectorMultiplyAdd(VectorSetFloat1(2.443315711809948e-5f), z, VectorSetFloat1(-1.388731625493765e-3f));
+	cosR = VectorMultiplyAdd(cosR, z, VectorSetFloat1(4.166664568298827e-2f));
+	cosR = VectorMultiply(VectorMultiply(cosR, z), z);
+	cosR = VectorAdd(VectorMultiplyAdd(VectorSetFloat1(-0.5f), z, cosR), VectorOne());
+
+	VectorRegister sinR = VectorMultiplyAdd(VectorSetFloat1(-1.9515295891e-4f), z, VectorSetFloat1(8.3321608736e-3f));
+	sinR = VectorMultiplyAdd(sinR, z, VectorSetFloat1(-1.6666654611e-1f));
+	sinR = VectorMultiplyAdd(VectorMultiply(sinR, z), r, r);
+
+	// sin(q pi/2 + r) and cos(q pi/2 + r) swap for odd q and change sign when q mod 4 is 2 or 3,
+	// respectively 1 or 2.
+	const VectorRegister bSwap = VectorCompareNE(VectorMultiply(q, VectorSetFloat1(0.5f)), VectorTruncate(VectorMultiply(q, VectorSetFloat1(0.5f))));
+
+	const VectorRegister qMod4 = VectorSubtract(q, VectorMultiply(VectorTruncate(VectorMultiply(q, VectorSetFloat1(0.25f))), VectorSetFloat1(4.0f)));
+	const VectorRegister bNegateSin = VectorCompareGE(qMod4, VectorSetFloat1(2.0f));
+	const VectorRegister bNegateCos = VectorBitwiseAnd(VectorCompareGE(qMod4, VectorOne()), VectorCompareLE(qMod4, VectorSetFloat1(2.0f)));
+
+	const VectorRegister sinSign = VectorBitwiseXor(VectorBitwiseAnd(bNegateSin, signBit), VectorBitwiseAnd(angles, signBit));
+	outSin = VectorBitwiseXor(VectorSelect(bSwap, cosR, sinR), sinSign);
+	outCos = VectorBitwiseXor(VectorSelect(bSwap, sinR, cosR), VectorBitwiseAnd(bNegateCos, signBit));
+}
+
+namespace Private
+{
+	/** Arcsine of a in [0, 1] with the pieces acos needs: the value returned is asin(s), where s = a below 0.5. */
+	FORCEINLINE VectorRegister VectorAsinKernel(VectorRegister a, VectorRegister bLarge)
+	{
+		// Above 0.5, asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2)).
+		const VectorRegister z = VectorSelect(bLarge, VectorMultiply(VectorSubtract(VectorOne(), a), VectorSetFloat1(0.5f)), VectorMultiply(a, a));
+		const VectorRegister s = VectorSelect(bLarge, VectorSqrt(z), a);
+
+		VectorRegister p = VectorMultiplyAdd(VectorSetFloat1(4.2163199048e-2f), z, VectorSetFloat1(2.4181311049e-2f));
+		p = VectorMultiplyAdd(p, z, VectorSetFloat1(4.5470025998e-2f));
+		p = VectorMultiplyAdd(p, z, VectorSetFloat1(7.4953002686e-2f));
+		p = VectorMultiplyAdd(p, z, VectorSetFloat1(1.6666752422e-1f));
+		return VectorMultiplyAdd(VectorMultiply(p, z), s, s);
+	}
+}
+
+/** Max error 2.5 ULP over [-1, 1], NaN outside. */
+FORCEINLINE VectorRegister VectorAsin(VectorRegister x)
+{
+	const VectorRegister a = VectorAbs(x);
+	const VectorRegister bLarge = VectorCompareGT(a, VectorSetFloat1(0.5f));
+	const VectorRegister p = Private::VectorAsinKernel(a, bLarge);
+
+	const VectorRegister result = VectorSelect(bLarge, VectorMultiplyAdd(p, VectorSetFloat1(-2.0f), VectorSetFloat1(1.57079632679489661923f)), p);
+	return VectorBitwiseXor(result, VectorBitwiseAnd(x, VectorSetFloat1(-0.0f)));
+}
+
+/** Max error 2 ULP over [-1, 1], NaN outside. */
+FORCEINLINE VectorRegister VectorAcos(VectorRegister x)
+{
+	const VectorRegister a = VectorAbs(x);
+	const VectorRegister bLarge = VectorCompareGT(a, VectorSetFloat1(0.5f));
+	const VectorRegister p = Private::VectorAsinKernel(a, bLarge);
+
+	// Above 0.5, acos(a) = 2 asin(sqrt((1 - a) / 2)) and acos(-a) = pi - acos(a). Below, acos(x) = pi/2 - asin(x).
+	VectorRegister large = VectorAdd(p, p);
+	large = VectorSelect(VectorCompareLT(x, VectorZero()), VectorSubtract(VectorSetFloat1(3.14159265358979323846f), large), large);
+
+	const VectorRegister small = VectorSubtract(VectorSetFloat1(1.57079632679489661923f), VectorBitwiseXor(p, VectorBitwiseAnd(x, VectorSetFloat1(-0.0f))));
+	return VectorSelect(bLarge, large, small);
+}
+
+/** Angle of (x, y) in [-pi, pi]. Max error 3 ULP for finite inputs; atan2(0, 0) is 0. */
+FORCEINLINE VectorRegister VectorAtan2(VectorRegister y, VectorRegister x)
+{
+	const VectorRegister ax = VectorAbs(x);
+	const VectorRegister ay = VectorAbs(y);
+	const VectorRegister high = VectorMax(ax, ay);
+	const VectorRegister low = VectorMin(ax, ay);
+
+	// atan(low / high) lies in [0, pi/4]. Above tan(pi/8) it is pi/4 + atan((low - high) / (low + high)).
+	const VectorRegister bReduce = VectorCompareGT(low, VectorMultiply(high, VectorSetFloat1(0.4142135623730950f)));
+	const VectorRegister t = VectorDivide(VectorSelect(bReduce, VectorSubtract(low, high), low), VectorSelect(bReduce, VectorAdd(low, high), high));
+	const VectorRegister z = VectorMultiply(t, t);
+
+	VectorRegister result = VectorMultiplyAdd(VectorSetFloat1(8.05374449538e-2f), z, VectorSetFloat1(-1.38776856032e-1f));
+	result = VectorMultiplyAdd(result, z, VectorSetFloat1(1.99777106478e-1f));
+	result = VectorMultiplyAdd(result, z, VectorSetFloat1(-3.33329491539e-1f));
+	result = VectorMultiplyAdd(VectorMultiply(result, z), t, t);
+	result = VectorAdd(result, VectorBitwiseAnd(bReduce, VectorSetFloat1(0.78539816339744830962f)));
+
+	// Unfold the octant: mirror around pi/4 when |y| > |x|, around pi/2 when x < 0, then take the sign of y.
+	result = VectorSelect(VectorCompareGT(ay, ax), VectorSubtract(VectorSetFloat1(1.57079632679489661923f), result), result);
+	result = VectorSelect(VectorCompareLT(x, VectorZero()), VectorSubtract(VectorSetFloat1(3.14159265358979323846f), result), result);
+	result = VectorSelect(VectorCompareEQ(high, VectorZero()), VectorZero(), result);
+	return VectorBitwiseXor(result, VectorBitwiseAnd(y, VectorSetFloat1(-0.0f)));
+}
+
+/** e^x. Max error 2 ULP for normal results; overflows to infinity above 88.72 and underflows through the denormals. */
+FORCEINLINE VectorRegister VectorExp(VectorRegister x)
+{
+	const VectorRegister maxX = VectorSetFloat1(88.72283905206835f);
+	const VectorRegister minX = VectorSetFloat1(-103.972077083991796f);
+	const VectorRegister clamped = VectorMin(VectorMax(x, minX), maxX);
+
+	// e^x = 2^n e^r with n = round(x / ln 2) and r = x - n ln 2, ln 2 split in two parts.
+	const VectorRegister n = VectorRound(VectorMultiply(clamped, VectorSetFloat1(1.44269504088896341f)));
+	VectorRegister r = VectorMultiplyAdd(n, VectorSetFloat1(-0.693359375f), clamped);
+	r = VectorMultiplyAdd(n, VectorSetFloat1(2.12194440e-4f), r);
+	const VectorRegister z = VectorMultiply(r, r);
+
+	VectorRegister p = VectorMultiplyAdd(VectorSetFloat1(1.9875691500e-4f), r, VectorSetFloat1(1.3981999507e-3f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(8.3334519073e-3f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(4.1665795894e-2f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(1.6666665459e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(5.0000001201e-1f));
+	p = VectorAdd(VectorMultiplyAdd(p, z, r), VectorOne());
+
+	// n reaches [-150, 128], so 2^n is applied in two halves that stay within the exponent range.
+	const VectorRegister n0 = VectorTruncate(VectorMultiply(n, VectorSetFloat1(0.5f)));
+	VectorRegister result = VectorMultiply(VectorMultiply(p, VectorPow2(n0)), VectorPow2(VectorSubtract(n, n0)));
+
+	result = VectorSelect(VectorCompareGT(x, maxX), VectorSetFloat1(INFINITY), result);
+	result = VectorSelect(VectorCompareLT(x, minX), VectorZero(), result);
+	return VectorSelect(VectorCompareNE(x, x), x, result);
+}
+
+/** Natural logarithm. Max error 2 ULP for positive inputs, denormals included; -infinity at 0 and NaN below. */
+FORCEINLINE VectorRegister VectorLog(VectorRegister x)
+{
+	// Denormals are scaled into the normal range first.
+	const VectorRegister bDenormal = VectorCompareLT(x, VectorSetFloat1(1.17549435e-38f));
+	const VectorRegister normal = VectorSelect(bDenormal, VectorMultiply(x, VectorSetFloat1(8388608.0f)), x);
+
+	VectorRegister e;
+	const VectorRegister m = VectorFrexp(normal, e);
+	e = VectorSubtract(e, VectorBitwiseAnd(bDenormal, VectorSetFloat1(23.0f)));
+
+	// log(x) = e ln 2 + log(1 + r), with the mantissa moved to [sqrt(0.5), sqrt(2)) so r is small.
+	const VectorRegister bLow = VectorCompareLT(m, VectorSetFloat1(0.707106781186547524f));
+	e = VectorSubtract(e, VectorBitwiseAnd(bLow, VectorOne()));
+	const VectorRegister r = VectorSubtract(VectorSelect(bLow, VectorAdd(m, m), m), VectorOne());
+	const VectorRegister z = VectorMultiply(r, r);
+
+	VectorRegister p = VectorMultiplyAdd(VectorSetFloat1(7.0376836292e-2f), r, VectorSetFloat1(-1.1514610310e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(1.1676998740e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(-1.2420140846e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(1.4249322787e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(-1.6668057665e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(2.0000714765e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(-2.4999993993e-1f));
+	p = VectorMultiplyAdd(p, r, VectorSetFloat1(3.3333331174e-1f));
+	p = VectorMultiply(VectorMultiply(p, r), z);
+
+	p = VectorMultiplyAdd(e, VectorSetFloat1(-2.12194440e-4f), p);
+	p = VectorMultiplyAdd(z, VectorSetFloat1(-0.5f), p);
+	VectorRegister result = VectorMultiplyAdd(e, VectorSetFloat1(0.693359375f), VectorAdd(r, p));
+
+	result = VectorSelect(VectorCompareEQ(x, VectorSetFloat1(INFINITY)), x, result);
+	result = VectorSelect(VectorCompareEQ(x, VectorZero()), VectorSetFloat1(-INFINITY), result);
+	return VectorSelect(VectorCompareLT(x, VectorZero()), VectorSetFloat1(NAN), VectorSelect(VectorCompareNE(x, x), x, result));
+}
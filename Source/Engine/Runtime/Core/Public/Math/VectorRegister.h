@@ -0,0 +1,93 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+// ---------------------------------------------------------------------------
+//	Instruction sets the math code may assume, known at compile time.
+// ---------------------------------------------------------------------------
+
+#if !defined(PLATFORM_ENABLE_VECTORINTRINSICS)
+	#if PLATFORM_CPU_X86_FAMILY && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+		#define PLATFORM_ENABLE_VECTORINTRINSICS 1
+	#else
+		#define PLATFORM_ENABLE_VECTORINTRINSICS 0
+	#endif
+#endif
+
+#if !defined(PLATFORM_ALWAYS_HAS_SSE4_1)
+	#if PLATFORM_ENABLE_VECTORINTRINSICS && (defined(__SSE4_1__) || defined(__AVX__))
+		#define PLATFORM_ALWAYS_HAS_SSE4_1 1
+	#else
+		#define PLATFORM_ALWAYS_HAS_SSE4_1 0
+	#endif
+#endif
+
+#if !defined(PLATFORM_ALWAYS_HAS_AVX)
+	#if PLATFORM_ENABLE_VECTORINTRINSICS && defined(__AVX__)
+		#define PLATFORM_ALWAYS_HAS_AVX 1
+	#else
+		#define PLATFORM_ALWAYS_HAS_AVX 0
+	#endif
+#endif
+
+#if !defined(PLATFORM_ALWAYS_HAS_AVX2)
+	#if PLATFORM_ENABLE_VECTORINTRINSICS && defined(__AVX2__)
+		#define PLATFORM_ALWAYS_HAS_AVX2 1
+	#else
+		#define PLATFORM_ALWAYS_HAS_AVX2 0
+	#endif
+#endif
+
+#if !defined(PLATFORM_ALWAYS_HAS_FMA3)
+	#if PLATFORM_ENABLE_VECTORINTRINSICS && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define PLATFORM_ALWAYS_HAS_FMA3 1
+	#else
+		#define PLATFORM_ALWAYS_HAS_FMA3 0
+	#endif
+#endif
+
+/**
+ * VectorRegister is four floats held in a SIMD register, manipulated through the free Vector* functions.
+ * The SSE implementation is used on x86 and uses SSE4.1, AVX and FMA3 where the compiler may assume them;
+ * elsewhere a scalar implementation with the same interface is used.
+ */
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	#include "Math/VectorRegisterSSE.h"
+#else
+	#include "Math/VectorRegisterScalar.h"
+#endif
+
+/*--------------------------------------------------------------------------*/
+
+/** Returns the cross product of the XYZ components, with W set to zero. */
+FORCEINLINE VectorRegister VectorCross3(VectorRegister a, VectorRegister b)
+{
+	const VectorRegister t = VectorSubtract(VectorMultiply(a, VectorSwizzle<1, 2, 0, 3>(b)), VectorMultiply(VectorSwizzle<1, 2, 0, 3>(a), b));
+	return VectorSwizzle<1, 2, 0, 3>(t);
+}
+
+/** Returns the quaternion product a * b, components in (X, Y, Z, W) order. */
+FORCEINLINE VectorRegister VectorQuaternionMultiply(VectorRegister a, VectorRegister b)
+{
+	VectorRegister result = VectorMultiply(VectorReplicate<3>(a), b);
+	result = VectorMultiplyAdd(VectorReplicate<0>(a), VectorMultiply(VectorSwizzle<3, 2, 1, 0>(b), VectorSet(1.0f, -1.0f, 1.0f, -1.0f)), result);
+	result = VectorMultiplyAdd(VectorReplicate<1>(a), VectorMultiply(VectorSwizzle<2, 3, 0, 1>(b), VectorSet(1.0f, 1.0f, -1.0f, -1.0f)), result);
+	result = VectorMultiplyAdd(VectorReplicate<2>(a), VectorMultiply(VectorSwizzle<1, 0, 3, 2>(b), VectorSet(-1.0f, 1.0f, 1.0f, -1.0f)), result);
+	return result;
+}
+
+/** Returns the conjugate of a quaternion, its inverse when it is normalized. */
+FORCEINLINE VectorRegister VectorQuaternionConjugate(VectorRegister q)
+{
+	return VectorMultiply(q, VectorSet(-1.0f, -1.0f, -1.0f, 1.0f));
+}
+
+/** Rotates the XYZ components of v by the normalized quaternion q. W of v is kept. */
+FORCEINLINE VectorRegister VectorQuaternionRotateVector(VectorRegister q, VectorRegister v)
+{
+	// v + 2w (q x v) + 2 q x (q x v)
+	const VectorRegister uv = VectorCross3(q, v);
+	const VectorRegister uuv = VectorCross3(q, uv);
+	const VectorRegister two = VectorSetFloat1(2.0f);
+	return VectorMultiplyAdd(VectorMultiplyAdd(uv, VectorReplicate<3>(q), uuv), two, v);
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+#if PLATFORM_ALWAYS_HAS_AVX || PLATFORM_ALWAYS_HAS_FMA3
+	#include <immintrin.h>
+#elif PLATFORM_ALWAYS_HAS_SSE4_1
+	#include <smmintrin.h>
+#else
+	#include <emmintrin.h>
+#endif
+
+#include <string.h>
+
+typedef __m128 VectorRegister;
+
+/*--------------------------------------------------------------------------*/
+
+FORCEINLINE VectorRegister VectorZero()
+{
+	return _mm_setzero_ps();
+}
+
+FORCEINLINE VectorRegister VectorOne()
+{
+	return _mm_set1_ps(1.0f);
+}
+
+FORCEINLINE VectorRegister VectorSet(float x, float y, float z, float w)
+{
+	return _mm_setr_ps(x, y, z, w);
+}
+
+FORCEINLINE VectorRegister VectorSetFloat1(float value)
+{
+	return _mm_set1_ps(value);
+}
+
+FORCEINLINE VectorRegister VectorLoad(const float* ptr)
+{
+	return _mm_loadu_ps(ptr);
+}
+
+/** Loads from a 16 byte aligned address. */
+FORCEINLINE VectorRegister VectorLoadAligned(const float* ptr)
+{
+	return _mm_load_ps(ptr);
+}
+
+FORCEINLINE void VectorStore(VectorRegister v, float* ptr)
+{
+	_mm_storeu_ps(ptr, v);
+}
+
+FORCEINLINE void VectorStoreAligned(VectorRegister v, float* ptr)
+{
+	_mm_store_ps(ptr, v);
+}
+
+/** Loads four bytes as floats in [0, 255]. */
+FORCEINLINE VectorRegister VectorLoadByte4(const u8* ptr)
+{
+	i32 bytes;
+	memcpy(&bytes, ptr, sizeof(bytes));
+	const __m128i zero = _mm_setzero_si128();
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero));
+}
+
+/** Rounds to the nearest integer, ties to even, and stores as four bytes. Components must be in [0, 255]. */
+FORCEINLINE void VectorStoreByte4(VectorRegister v, u8* ptr)
+{
+	const __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(v), _mm_setzero_si128());
+	const i32 bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+	memcpy(ptr, &bytes, sizeof(bytes));
+}
+
+template<i32 Index>
+FORCEINLINE float VectorGetComponent(VectorRegister v)
+{
+	return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Index, Index, Index, Index)));
+}
+
+template<i32 Index>
+FORCEINLINE VectorRegister VectorReplicate(VectorRegister v)
+{
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Index, Index, Index, Index));
+}
+
+/** Returns (v[X], v[Y], v[Z], v[W]). */
+template<i32 X, i32 Y, i32 Z, i32 W>
+FORCEINLINE VectorRegister VectorSwizzle(VectorRegister v)
+{
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/** Returns (a[X], a[Y], b[Z], b[W]). */
+template<i32 X, i32 Y, i32 Z, i32 W>
+FORCEINLINE VectorRegister VectorShuffle(VectorRegister a, VectorRegister b)
+{
+	return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/*--------------------------------------------------------------------------*/
+
+FORCEINLINE VectorRegister VectorAdd(VectorRegister a, VectorRegister b) { return _mm_add_ps(a, b); }
+FORCEINLINE VectorRegister VectorSubtract(VectorRegister a, VectorRegister b) { return _mm_sub_ps(a, b); }
+FORCEINLINE VectorRegister VectorMultiply(VectorRegister a, VectorRegister b) { return _mm_mul_ps(a, b); }
+FORCEINLINE VectorRegister VectorDivide(VectorRegister a, VectorRegister b) { return _mm_div_ps(a, b); }
+FORCEINLINE VectorRegister VectorMin(VectorRegister a, VectorRegister b) { return _mm_min_ps(a, b); }
+FORCEINLINE VectorRegister VectorMax(VectorRegister a, VectorRegister b) { return _mm_max_ps(a, b); }
+FORCEINLINE VectorRegister VectorNegate(VectorRegister v) { return _mm_sub_ps(_mm_setzero_ps(), v); }
+FORCEINLINE VectorRegister VectorAbs(VectorRegister v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+FORCEINLINE VectorRegister VectorSqrt(VectorRegister v) { return _mm_sqrt_ps(v); }
+
+/** Returns 1 / sqrt(v) with about 12 bits of precision. */
+FORCEINLINE VectorRegister VectorReciprocalSqrtEstimate(VectorRegister v) { return _mm_rsqrt_ps(v); }
+
+/*--------------------------------------------------------------------------*/
+
+// Comparisons return a mask with all bits of a component set where the comparison holds.
+
+FORCEINLINE VectorRegister VectorCompareEQ(VectorRegister a, VectorRegister b) { return _mm_cmpeq_ps(a, b); }
+FORCEINLINE VectorRegister VectorCompareNE(VectorRegister a, VectorRegister b) { return _mm_cmpneq_ps(a, b); }
+FORCEINLINE VectorRegister VectorCompareLT(VectorRegister a, VectorRegister b) { return _mm_cmplt_ps(a, b); }
+FORCEINLINE VectorRegister VectorCompareLE(VectorRegister a, VectorRegister b) { return _mm_cmple_ps(a, b); }
+FORCEINLINE VectorRegister VectorCompareGT(VectorRegister a, VectorRegister b) { return _mm_cmpgt_ps(a, b); }
+FORCEINLINE VectorRegister VectorCompareGE(VectorRegister a, VectorRegister b) { return _mm_cmpge_ps(a, b); }
+
+FORCEINLINE VectorRegister VectorBitwiseAnd(VectorRegister a, VectorRegister b) { return _mm_and_ps(a, b); }
+FORCEINLINE VectorRegister VectorBitwiseOr(VectorRegister a, VectorRegister b) { return _mm_or_ps(a, b); }
+FORCEINLINE VectorRegister VectorBitwiseXor(VectorRegister a, VectorRegister b) { return _mm_xor_ps(a, b); }
+
+/** Returns the sign bits of the components in bits 0 to 3, e.g. 0xF when a comparison held for all four. */
+FORCEINLINE i32 VectorMaskBits(VectorRegister mask) { return _mm_movemask_ps(mask); }
+
+/** Returns mask ? a : b per component, mask coming from a comparison. */
+FORCEINLINE VectorRegister VectorSelect(VectorRegister mask, VectorRegister a, VectorRegister b)
+{
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+	return _mm_blendv_ps(b, a, mask);
+#else
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif
+}
+
+/** Rounds to the nearest integer, ties to even. Components must be within the i32 range. */
+FORCEINLINE VectorRegister VectorRound(VectorRegister v)
+{
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+	return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+	return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));
+#endif
+}
+
+/** Rounds toward zero. Components must be within the i32 range. */
+FORCEINLINE VectorRegister VectorTruncate(VectorRegister v)
+{
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+	return _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+#else
+	return _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+#endif
+}
+
+/** Returns 2^n for integral n in [-126, 127]. */
+FORCEINLINE VectorRegister VectorPow2(VectorRegister n)
+{
+	return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23));
+}
+
+/** Splits positive normal components into a mantissa in [0.5, 1), returned, and an integral exponent. */
+FORCEINLINE VectorRegister VectorFrexp(VectorRegister v, VectorRegister& outExponent)
+{
+	const __m128i bits = _mm_castps_si128(v);
+	outExponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+	return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000)));
+}
+
+/*--------------------------------------------------------------------------*/
+
+/** Returns a * b + c, fused when FMA3 is available. */
+FORCEINLINE VectorRegister VectorMultiplyAdd(VectorRegister a, VectorRegister b, VectorRegister c)
+{
+#if PLATFORM_ALWAYS_HAS_FMA3
+	return _mm_fmadd_ps(a, b, c);
+#else
+	return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+/** Returns the dot product of the four components, replicated to all of them. */
+FORCEINLINE VectorRegister VectorDot4(VectorRegister a, VectorRegister b)
+{
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+	return _mm_dp_ps(a, b, 0xFF);
+#else
+	VectorRegister t = _mm_mul_ps(a, b);
+	t = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+#endif
+}
+
+FORCEINLINE void VectorTranspose4x4(VectorRegister& r0, VectorRegister& r1, VectorRegister& r2, VectorRegister& r3)
+{
+	const VectorRegister t0 = _mm_unpacklo_ps(r0, r1);
+	const VectorRegister t1 = _mm_unpacklo_ps(r2, r3);
+	const VectorRegister t2 = _mm_unpackhi_ps(r0, r1);
+	const VectorRegister t3 = _mm_unpackhi_ps(r2, r3);
+
+	r0 = _mm_movelh_ps(t0, t1);
+	r1 = _mm_movehl_ps(t1, t0);
+	r2 = _mm_movelh_ps(t2, t3);
+	r3 = _mm_movehl_ps(t3, t2);
+}
+
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Multiplies two row major 4x4 float matrices, result = lhs * rhs. Result may alias either input.
+ * Each result row is the rhs rows weighted by the components of the lhs row.
+ */
+FORCEINLINE void VectorMatrixMultiply(float* result, const float* lhs, const float* rhs)
+{
+#if PLATFORM_ALWAYS_HAS_AVX
+	// Two result rows per 256 bit register.
+	const __m256 b0 = _mm256_broadcast_ps((const __m128*)(rhs + 0));
+	const __m256 b1 = _mm256_broadcast_ps((const __m128*)(rhs + 4));
+	const __m256 b2 = _mm256_broadcast_ps((const __m128*)(rhs + 8));
+	const __m256 b3 = _mm256_broadcast_ps((const __m128*)(rhs + 12));
+
+	const __m256 a01 = _mm256_loadu_ps(lhs + 0);
+	const __m256 a23 = _mm256_loadu_ps(lhs + 8);
+
+	__m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+	__m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+
+#if PLATFORM_ALWAYS_HAS_FMA3
+	r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1, r01);
+	r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1, r23);
+	r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2, r01);
+	r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2, r23);
+	r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3, r01);
+	r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3, r23);
+#else
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+#endif
+
+	_mm256_storeu_ps(result + 0, r01);
+	_mm256_storeu_ps(result + 8, r23);
+#else
+	const VectorRegister b0 = VectorLoad(rhs + 0);
+	const VectorRegister b1 = VectorLoad(rhs + 4);
+	const VectorRegister b2 = VectorLoad(rhs + 8);
+	const VectorRegister b3 = VectorLoad(rhs + 12);
+
+	VectorRegister rows[4];
+	for (i32 row = 0; row < 4; ++row)
+	{
+		const VectorRegister a = VectorLoad(lhs + row * 4);
+
+		VectorRegister r = VectorMultiply(VectorReplicate<0>(a), b0);
+		r = VectorMultiplyAdd(VectorReplicate<1>(a), b1, r);
+		r = VectorMultiplyAdd(VectorReplicate<2>(a), b2, r);
+		rows[row] = VectorMultiplyAdd(VectorReplicate<3>(a), b3, r);
+	}
+
+	for (i32 row = 0; row < 4; ++row)
+	{
+		VectorStore(rows[row], result + row * 4);
+	}
+#endif
+}
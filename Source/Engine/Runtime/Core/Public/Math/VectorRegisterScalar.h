@@ -0,0 +1,312 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+#include <cmath>
+#include <string.h>
+
+struct alignas(16) VectorRegister
+{
+	float V[4];
+};
+
+/*--------------------------------------------------------------------------*/
+
+FORCEINLINE VectorRegister VectorSet(float x, float y, float z, float w)
+{
+	return VectorRegister{ { x, y, z, w } };
+}
+
+FORCEINLINE VectorRegister VectorZero()
+{
+	return VectorSet(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+FORCEINLINE VectorRegister VectorOne()
+{
+	return VectorSet(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+FORCEINLINE VectorRegister VectorSetFloat1(float value)
+{
+	return VectorSet(value, value, value, value);
+}
+
+FORCEINLINE VectorRegister VectorLoad(const float* ptr)
+{
+	return VectorSet(ptr[0], ptr[1], ptr[2], ptr[3]);
+}
+
+/** Loads from a 16 byte aligned address. */
+FORCEINLINE VectorRegister VectorLoadAligned(const float* ptr)
+{
+	return VectorLoad(ptr);
+}
+
+FORCEINLINE void VectorStore(VectorRegister v, float* ptr)
+{
+	ptr[0] = v.V[0];
+	ptr[1] = v.V[1];
+	ptr[2] = v.V[2];
+	ptr[3] = v.V[3];
+}
+
+FORCEINLINE void VectorStoreAligned(VectorRegister v, float* ptr)
+{
+	VectorStore(v, ptr);
+}
+
+/** Loads four bytes as floats in [0, 255]. */
+FORCEINLINE VectorRegister VectorLoadByte4(const u8* ptr)
+{
+	return VectorSet((float)ptr[0], (float)ptr[1], (float)ptr[2], (float)ptr[3]);
+}
+
+/** Rounds to the nearest integer, ties to even, and stores as four bytes. Components must be in [0, 255]. */
+FORCEINLINE void VectorStoreByte4(VectorRegister v, u8* ptr)
+{
+	ptr[0] = (u8)std::nearbyint(v.V[0]);
+	ptr[1] = (u8)std::nearbyint(v.V[1]);
+	ptr[2] = (u8)std::nearbyint(v.V[2]);
+	ptr[3] = (u8)std::nearbyint(v.V[3]);
+}
+
+template<i32 Index>
+FORCEINLINE float VectorGetComponent(VectorRegister v)
+{
+	return v.V[Index];
+}
+
+template<i32 Index>
+FORCEINLINE VectorRegister VectorReplicate(VectorRegister v)
+{
+	return VectorSetFloat1(v.V[Index]);
+}
+
+/** Returns (v[X], v[Y], v[Z], v[W]). */
+template<i32 X, i32 Y, i32 Z, i32 W>
+FORCEINLINE VectorRegister VectorSwizzle(VectorRegister v)
+{
+	return VectorSet(v.V[X], v.V[Y], v.V[Z], v.V[W]);
+}
+
+/** Returns (a[X], a[Y], b[Z], b[W]). */
+template<i32 X, i32 Y, i32 Z, i32 W>
+FORCEINLINE VectorRegister VectorShuffle(VectorRegister a, VectorRegister b)
+{
+	return VectorSet(a.V[X], a.V[Y], b.V[Z], b.V[W]);
+}
+
+/*--------------------------------------------------------------------------*/
+
+#define VECTOR_SCALAR_BINARY_OP(Name, Expression) \
+	FORCEINLINE VectorRegister Name(VectorRegister a, VectorRegister b) \
+	{ \
+		VectorRegister r; \
+		for (i32 i = 0; i < 4; ++i) \
+		{ \
+			r.V[i] = Expression; \
+		} \
+		return r; \
+	}
+
+VECTOR_SCALAR_BINARY_OP(VectorAdd, a.V[i] + b.V[i])
+VECTOR_SCALAR_BINARY_OP(VectorSubtract, a.V[i] - b.V[i])
+VECTOR_SCALAR_BINARY_OP(VectorMultiply, a.V[i] * b.V[i])
+VECTOR_SCALAR_BINARY_OP(VectorDivide, a.V[i] / b.V[i])
+VECTOR_SCALAR_BINARY_OP(VectorMin, a.V[i] < b.V[i] ? a.V[i] : b.V[i])
+VECTOR_SCALAR_BINARY_OP(VectorMax, a.V[i] > b.V[i] ? a.V[i] : b.V[i])
+
+#undef VECTOR_SCALAR_BINARY_OP
+
+FORCEINLINE VectorRegister VectorNegate(VectorRegister v)
+{
+	return VectorSet(-v.V[0], -v.V[1], -v.V[2], -v.V[3]);
+}
+
+FORCEINLINE VectorRegister VectorAbs(VectorRegister v)
+{
+	return VectorSet(v.V[0] < 0.0f ? -v.V[0] : v.V[0], v.V[1] < 0.0f ? -v.V[1] : v.V[1], v.V[2] < 0.0f ? -v.V[2] : v.V[2], v.V[3] < 0.0f ? -v.V[3] : v.V[3]);
+}
+
+FORCEINLINE VectorRegister VectorSqrt(VectorRegister v)
+{
+	return VectorSet(std::sqrt(v.V[0]), std::sqrt(v.V[1]), std::sqrt(v.V[2]), std::sqrt(v.V[3]));
+}
+
+/** Returns 1 / sqrt(v). The scalar implementation is exact rather than an estimate. */
+FORCEINLINE VectorRegister VectorReciprocalSqrtEstimate(VectorRegister v)
+{
+	return VectorSet(1.0f / std::sqrt(v.V[0]), 1.0f / std::sqrt(v.V[1]), 1.0f / std::sqrt(v.V[2]), 1.0f / std::sqrt(v.V[3]));
+}
+
+/*--------------------------------------------------------------------------*/
+
+namespace Private
+{
+	FORCEINLINE u32 VectorAsBits(float value)
+	{
+		u32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	FORCEINLINE float VectorFromBits(u32 bits)
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	FORCEINLINE float VectorMaskFromBool(bool bValue)
+	{
+		return VectorFromBits(bValue ? 0xFFFFFFFFu : 0u);
+	}
+}
+
+// Comparisons return a mask with all bits of a component set where the comparison holds.
+
+#define VECTOR_SCALAR_COMPARE_OP(Name, Operator) \
+	FORCEINLINE VectorRegister Name(VectorRegister a, VectorRegister b) \
+	{ \
+		VectorRegister r; \
+		for (i32 i = 0; i < 4; ++i) \
+		{ \
+			r.V[i] = Private::VectorMaskFromBool(a.V[i] Operator b.V[i]); \
+		} \
+		return r; \
+	}
+
+VECTOR_SCALAR_COMPARE_OP(VectorCompareEQ, ==)
+VECTOR_SCALAR_COMPARE_OP(VectorCompareNE, !=)
+VECTOR_SCALAR_COMPARE_OP(VectorCompareLT, <)
+VECTOR_SCALAR_COMPARE_OP(VectorCompareLE, <=)
+VECTOR_SCALAR_COMPARE_OP(VectorCompareGT, >)
+VECTOR_SCALAR_COMPARE_OP(VectorCompareGE, >=)
+
+#undef VECTOR_SCALAR_COMPARE_OP
+
+#define VECTOR_SCALAR_BITWISE_OP(Name, Operator) \
+	FORCEINLINE VectorRegister Name(VectorRegister a, VectorRegister b) \
+	{ \
+		VectorRegister r; \
+		for (i32 i = 0; i < 4; ++i) \
+		{ \
+			r.V[i] = Private::VectorFromBits(Private::VectorAsBits(a.V[i]) Operator Private::VectorAsBits(b.V[i])); \
+		} \
+		return r; \
+	}
+
+VECTOR_SCALAR_BITWISE_OP(VectorBitwiseAnd, &)
+VECTOR_SCALAR_BITWISE_OP(VectorBitwiseOr, |)
+VECTOR_SCALAR_BITWISE_OP(VectorBitwiseXor, ^)
+
+#undef VECTOR_SCALAR_BITWISE_OP
+
+/** Returns the sign bits of the components in bits 0 to 3, e.g. 0xF when a comparison held for all four. */
+FORCEINLINE i32 VectorMaskBits(VectorRegister mask)
+{
+	i32 bits = 0;
+	for (i32 i = 0; i < 4; ++i)
+	{
+		bits |= (i32)(Private::VectorAsBits(mask.V[i]) >> 31) << i;
+	}
+	return bits;
+}
+
+/** Returns mask ? a : b per component, mask coming from a comparison. */
+FORCEINLINE VectorRegister VectorSelect(VectorRegister mask, VectorRegister a, VectorRegister b)
+{
+	VectorRegister r;
+	for (i32 i = 0; i < 4; ++i)
+	{
+		r.V[i] = Private::VectorAsBits(mask.V[i]) != 0 ? a.V[i] : b.V[i];
+	}
+	return r;
+}
+
+/** Rounds to the nearest integer, ties to even. Components must be within the i32 range. */
+FORCEINLINE VectorRegister VectorRound(VectorRegister v)
+{
+	return VectorSet(std::nearbyint(v.V[0]), std::nearbyint(v.V[1]), std::nearbyint(v.V[2]), std::nearbyint(v.V[3]));
+}
+
+/** Rounds toward zero. Components must be within the i32 range. */
+FORCEINLINE VectorRegister VectorTruncate(VectorRegister v)
+{
+	return VectorSet(std::trunc(v.V[0]), std::trunc(v.V[1]), std::trunc(v.V[2]), std::trunc(v.V[3]));
+}
+
+/** Returns 2^n for integral n in [-126, 127]. */
+FORCEINLINE VectorRegister VectorPow2(VectorRegister n)
+{
+	VectorRegister r;
+	for (i32 i = 0; i < 4; ++i)
+	{
+		r.V[i] = Private::VectorFromBits((u32)((i32)n.V[i] + 127) << 23);
+	}
+	return r;
+}
+
+/** Splits positive normal components into a mantissa in [0.5, 1), returned, and an integral exponent. */
+FORCEINLINE VectorRegister VectorFrexp(VectorRegister v, VectorRegister& outExponent)
+{
+	VectorRegister r;
+	for (i32 i = 0; i < 4; ++i)
+	{
+		const u32 bits = Private::VectorAsBits(v.V[i]);
+		outExponent.V[i] = (float)((i32)(bits >> 23) - 126);
+		r.V[i] = Private::VectorFromBits((bits & 0x007FFFFFu) | 0x3F000000u);
+	}
+	return r;
+}
+
+/*--------------------------------------------------------------------------*/
+
+/** Returns a * b + c. */
+FORCEINLINE VectorRegister VectorMultiplyAdd(VectorRegister a, VectorRegister b, VectorRegister c)
+{
+	return VectorAdd(VectorMultiply(a, b), c);
+}
+
+/** Returns the dot product of the four components, replicated to all of them. */
+FORCEINLINE VectorRegister VectorDot4(VectorRegister a, VectorRegister b)
+{
+	return VectorSetFloat1(a.V[0] * b.V[0] + a.V[1] * b.V[1] + a.V[2] * b.V[2] + a.V[3] * b.V[3]);
+}
+
+FORCEINLINE void VectorTranspose4x4(VectorRegister& r0, VectorRegister& r1, VectorRegister& r2, VectorRegister& r3)
+{
+	const VectorRegister t0 = VectorSet(r0.V[0], r1.V[0], r2.V[0], r3.V[0]);
+	const VectorRegister t1 = VectorSet(r0.V[1], r1.V[1], r2.V[1], r3.V[1]);
+	const VectorRegister t2 = VectorSet(r0.V[2], r1.V[2], r2.V[2], r3.V[2]);
+	const VectorRegister t3 = VectorSet(r0.V[3], r1.V[3], r2.V[3], r3.V[3]);
+
+	r0 = t0;
+	r1 = t1;
+	r2 = t2;
+	r3 = t3;
+}
+
+/*--------------------------------------------------------------------------*/
+
+/** Multiplies two row major 4x4 float matrices, result = lhs * rhs. Result may alias either input. */
+FORCEINLINE void VectorMatrixMultiply(float* result, const float* lhs, const float* rhs)
+{
+	float temp[16];
+	for (i32 row = 0; row < 4; ++row)
+	{
+		for (i32 col = 0; col < 4; ++col)
+		{
+			temp[row * 4 + col] = lhs[row * 4 + 0] * rhs[0 * 4 + col]
+				+ lhs[row * 4 + 1] * rhs[1 * 4 + col]
+				+ lhs[row * 4 + 2] * rhs[2 * 4 + col]
+				+ lhs[row * 4 + 3] * rhs[3 * 4 + col];
+		}
+	}
+
+	for (i32 i = 0; i < 16; ++i)
+	{
+		result[i] = temp[i];
+	}
+}
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "Math/Vector.h"
+#include "Math/Vector4.h"
+#include "Math/VectorRegister.h"
+#include "Memory/Memory.h"
+#include "Memory/MemoryOps.h"
+#include "TypeTraits.h"
+
+/**
+ * Array of 3 or 4 component vectors stored as one float stream per component (structure of arrays), so a
+ * SIMD register holds the same component of consecutive vectors.
+ * The streams live in one allocation, each one aligned to Alignment bytes and padded to a multiple of Lanes
+ * floats: loops may always process whole registers, the padding values are unspecified.
+ * The lane-wise statics mirror the FVector ones; their outputs may alias their inputs.
+ */
+template<i32 NumComponents>
+class TVectorSoA
+{
+	static_assert(NumComponents == 3 || NumComponents == 4, "TVectorSoA holds 3 or 4 component vectors.");
+
+public:
+
+	typedef typename TConditional<NumComponents == 4, FVector4, FVector>::Type ElementType;
+
+	/** Floats in a VectorRegister, every stream is padded to a multiple of it. */
+	CONSTEXPR static i32 Lanes = 4;
+	CONSTEXPR static u64 Alignment = Lanes * sizeof(float);
+
+public:
+
+	FORCEINLINE TVectorSoA() : m_Data(nullptr), m_Num(0), m_Max(0) { }
+
+	FORCEINLINE explicit TVectorSoA(i32 num) : TVectorSoA()
+	{
+		SetNum(num);
+	}
+
+	FORCEINLINE TVectorSoA(const ElementType* source, i32 count) : TVectorSoA()
+	{
+		CopyFrom(source, count);
+	}
+
+	FORCEINLINE TVectorSoA(const TVectorSoA& other) : TVectorSoA()
+	{
+		*this = other;
+	}
+
+	FORCEINLINE TVectorSoA(TVectorSoA&& other) : m_Data(other.m_Data), m_Num(other.m_Num), m_Max(other.m_Max)
+	{
+		other.m_Data = nullptr;
+		other.m_Num = 0;
+		other.m_Max = 0;
+	}
+
+	FORCEINLINE ~TVectorSoA()
+	{
+		GMalloc->Free(m_Data);
+	}
+
+public:
+
+	FORCEINLINE TVectorSoA& operator=(const TVectorSoA& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			Reserve(other.m_Num);
+			m_Num = other.m_Num;
+
+			for (i32 component = 0; component < NumComponents; ++component)
+			{
+				FMemory::Memcpy(GetComponent(component), other.GetComponent(component), (SIZE_T)GetPaddedNum() * sizeof(float));
+			}
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE TVectorSoA& operator=(TVectorSoA&& other)
+	{
+		if (this != &other)
+		{
+			GMalloc->Free(m_Data);
+
+			m_Data = other.m_Data;
+			m_Num = other.m_Num;
+			m_Max = other.m_Max;
+
+			other.m_Data = nullptr;
+			other.m_Num = 0;
+			other.m_Max = 0;
+		}
+
+		return *this;
+	}
+
+public:
+
+	FORCEINLINE i32 Num() const { return m_Num; }
+	FORCEINLINE i32 Max() const { return m_Max; }
+	FORCEINLINE bool IsEmpty() const { return m_Num == 0; }
+
+	/** Number of floats covered by whole registers, what lane-wise loops iterate over. */
+	FORCEINLINE i32 GetPaddedNum() const { return PadToLanes(m_Num); }
+
+	FORCEINLINE float* GetComponent(i32 component)
+	{
+		CHECK(component >= 0 && component < NumComponents);
+		return m_Data + (SIZE_T)component * m_Max;
+	}
+
+	FORCEINLINE const float* GetComponent(i32 component) const
+	{
+		CHECK(component >= 0 && component < NumComponents);
+		return m_Data + (SIZE_T)component * m_Max;
+	}
+
+	FORCEINLINE float* GetX() { return GetComponent(0); }
+	FORCEINLINE float* GetY() { return GetComponent(1); }
+	FORCEINLINE float* GetZ() { return GetComponent(2); }
+	FORCEINLINE float* GetW() { return GetComponent(3); }
+	FORCEINLINE const float* GetX() const { return GetComponent(0); }
+	FORCEINLINE const float* GetY() const { return GetComponent(1); }
+	FORCEINLINE const float* GetZ() const { return GetComponent(2); }
+	FORCEINLINE const float* GetW() const { return GetComponent(3); }
+
+	FORCEINLINE ElementType Get(i32 index) const
+	{
+		CHECK(index >= 0 && index < m_Num);
+
+		ElementType result;
+		for (i32 component = 0; component < NumComponents; ++component)
+		{
+			result[component] = GetComponent(component)[index];
+		}
+
+		return result;
+	}
+
+	FORCEINLINE void Set(i32 index, const ElementType& value)
+	{
+		CHECK(index >= 0 && index < m_Num);
+
+		for (i32 component = 0; component < NumComponents; ++component)
+		{
+			GetComponent(component)[index] = value[component];
+		}
+	}
+
+	FORCEINLINE i32 Add(const ElementType& value)
+	{
+		if (m_Num == m_Max)
+		{
+			Reserve(m_Max > 0 ? m_Max * 2 : Lanes);
+		}
+
+		SetNum(m_Num + 1);
+		Set(m_Num - 1, value);
+		return m_Num - 1;
+	}
+
+public:
+
+	/** Resizes to num vectors, new ones and the padding after them are zero. */
+	FORCEINLINE void SetNum(i32 num)
+	{
+		CHECK(num >= 0);
+		Reserve(num);
+
+		if (num > m_Num)
+		{
+			for (i32 component = 0; component < NumComponents; ++component)
+			{
+				FMemory::Memzero(GetComponent(component) + m_Num, (SIZE_T)(PadToLanes(num) - m_Num) * sizeof(float));
+			}
+		}
+
+		m_Num = num;
+	}
+
+	FORCEINLINE void Reserve(i32 num)
+	{
+		const i32 newMax = PadToLanes(num);
+		if (newMax <= m_Max)
+		{
+			return;
+		}
+
+		float* newData = (float*)GMalloc->Malloc((SIZE_T)newMax * NumComponents * sizeof(float), Alignment);
+		CHECK(newData != nullptr);
+
+		for (i32 component = 0; component < NumComponents && m_Num > 0; ++component)
+		{
+			FMemory::Memcpy(newData + (SIZE_T)component * newMax, GetComponent(component), (SIZE_T)m_Num * sizeof(float));
+		}
+
+		GMalloc->Free(m_Data);
+		m_Data = newData;
+		m_Max = newMax;
+	}
+
+	/** Removes all vectors, keeping the allocation. */
+	FORCEINLINE void Reset()
+	{
+		m_Num = 0;
+	}
+
+	FORCEINLINE void Empty()
+	{
+		GMalloc->Free(m_Data);
+		m_Data = nullptr;
+		m_Num = 0;
+		m_Max = 0;
+	}
+
+public:
+
+	/** Replaces the content with count vectors gathered from an AoS array. */
+	FORCEINLINE void CopyFrom(const ElementType* source, i32 count)
+	{
+		Reset();
+		SetNum(count);
+
+		for (i32 component = 0; component < NumComponents; ++component)
+		{
+			float* stream = GetComponent(component);
+			for (i32 i = 0; i < count; ++i)
+			{
+				stream[i] = source[i][component];
+			}
+		}
+	}
+
+	/** Scatters the Num() vectors into an AoS array. */
+	FORCEINLINE void CopyTo(ElementType* dest) const
+	{
+		for (i32 component = 0; component < NumComponents; ++component)
+		{
+			const float* stream = GetComponent(component);
+			for (i32 i = 0; i < m_Num; ++i)
+			{
+				dest[i][component] = stream[i];
+			}
+		}
+	}
+
+public:
+
+	/** Writes a.Num() dot products to outDots. */
+	FORCEINLINE static void Dot(const TVectorSoA& a, const TVectorSoA& b, float* outDots)
+	{
+		CHECK(a.Num() == b.Num());
+		ForEachRegister(a.Num(), outDots, [&](i32 i)
+		{
+			VectorRegister result = VectorMultiply(VectorLoadAligned(a.GetX() + i), VectorLoadAligned(b.GetX() + i));
+			for (i32 component = 1; component < NumComponents; ++component)
+			{
+				result = VectorMultiplyAdd(VectorLoadAligned(a.GetComponent(component) + i), VectorLoadAligned(b.GetComponent(component) + i), result);
+			}
+
+			return result;
+		});
+	}
+
+	/** Writes a.Num() distances to outDistances. */
+	FORCEINLINE static void Distance(const TVectorSoA& a, const TVectorSoA& b, float* outDistances)
+	{
+		CHECK(a.Num() == b.Num());
+		ForEachRegister(a.Num(), outDistances, [&](i32 i)
+		{
+			VectorRegister result = VectorZero();
+			for (i32 component = 0; component < NumComponents; ++component)
+			{
+				const VectorRegister delta = VectorSubtract(VectorLoadAligned(a.GetComponent(component) + i), VectorLoadAligned(b.GetComponent(component) + i));
+				result = VectorMultiplyAdd(delta, delta, result);
+			}
+
+			return VectorSqrt(result);
+		});
+	}
+
+	/** Cross product of the XYZ components; the W stream of a 4 component result is zero. */
+	FORCEINLINE static void Cross(const TVectorSoA& a, const TVectorSoA& b, TVectorSoA& out)
+	{
+		CHECK(a.Num() == b.Num());
+		out.SetNum(a.Num());
+
+		for (i32 i = 0; i < a.GetPaddedNum(); i += Lanes)
+		{
+			const VectorRegister ax = VectorLoadAligned(a.GetX() + i);
+			const VectorRegister ay = VectorLoadAligned(a.GetY() + i);
+			const VectorRegister az = VectorLoadAligned(a.GetZ() + i);
+			const VectorRegister bx = VectorLoadAligned(b.GetX() + i);
+			const VectorRegister by = VectorLoadAligned(b.GetY() + i);
+			const VectorRegister bz = VectorLoadAligned(b.GetZ() + i);
+
+			VectorStoreAligned(VectorSubtract(VectorMultiply(ay, bz), VectorMultiply(az, by)), out.GetX() + i);
+			VectorStoreAligned(VectorSubtract(VectorMultiply(az, bx), VectorMultiply(ax, bz)), out.GetY() + i);
+			VectorStoreAligned(VectorSubtract(VectorMultiply(ax, by), VectorMultiply(ay, bx)), out.GetZ() + i);
+			if constexpr (NumComponents == 4)
+			{
+				VectorStoreAligned(VectorZero(), out.GetW() + i);
+			}
+		}
+	}
+
+	/** Divides every vector by its length. Like FVector::Normalize, zero vectors aren't handled. */
+	FORCEINLINE static void Normalize(const TVectorSoA& v, TVectorSoA& out)
+	{
+		out.SetNum(v.Num());
+
+		for (i32 i = 0; i < v.GetPaddedNum(); i += Lanes)
+		{
+			VectorRegister components[NumComponents];
+			VectorRegister squaredLength = VectorZero();
+			for (i32 component = 0; component < NumComponents; ++component)
+			{
+				components[component] = VectorLoadAligned(v.GetComponent(component) + i);
+				squaredLength = VectorMultiplyAdd(components[component], components[component], squaredLength);
+			}
+
+			const VectorRegister length = VectorSqrt(squaredLength);
+			for (i32 component = 0; component < NumComponents; ++component)
+			{
+				VectorStoreAligned(VectorDivide(components[component], length), out.GetComponent(component) + i);
+			}
+		}
+	}
+
+	/** out = a + (b - a) * t for every vector. */
+	FORCEINLINE static void Lerp(const TVectorSoA& a, const TVectorSoA& b, float t, TVectorSoA& out)
+	{
+		CHECK(a.Num() == b.Num());
+		out.SetNum(a.Num());
+
+		const VectorRegister alpha = VectorSetFloat1(t);
+		for (i32 component = 0; component < NumComponents; ++component)
+		{
+			const float* aStream = a.GetComponent(component);
+			const float* bStream = b.GetComponent(component);
+			float* outStream = out.GetComponent(component);
+
+			for (i32 i = 0; i < a.GetPaddedNum(); i += Lanes)
+			{
+				const VectorRegister from = VectorLoadAligned(aStream + i);
+				const VectorRegister to = VectorLoadAligned(bStream + i);
+				VectorStoreAligned(VectorMultiplyAdd(VectorSubtract(to, from), alpha, from), outStream + i);
+			}
+		}
+	}
+
+private:
+
+	FORCEINLINE static i32 PadToLanes(i32 num)
+	{
+		return (num + Lanes - 1) & ~(Lanes - 1);
+	}
+
+	/** Runs body over every register of num lanes and stores its results to a plain array of num floats. */
+	template<typename FunctionType>
+	FORCEINLINE static void ForEachRegister(i32 num, float* dest, FunctionType&& body)
+	{
+		i32 i = 0;
+		for (; i + Lanes <= num; i += Lanes)
+		{
+			VectorStore(body(i), dest + i);
+		}
+
+		if (i < num)
+		{
+			float tail[Lanes];
+			VectorStore(body(i), tail);
+			FMemory::Memcpy(dest + i, tail, (SIZE_T)(num - i) * sizeof(float));
+		}
+	}
+
+private:
+
+	float* m_Data;
+	i32 m_Num;
+	i32 m_Max;
+};
+
+typedef TVectorSoA<3> FVectorSoA;
+typedef TVectorSoA<4> FVector4SoA;
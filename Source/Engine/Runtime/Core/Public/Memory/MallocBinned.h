@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Memory/Memory.h"
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * Small object allocator. Requests up to MaxBinnedSize bytes are rounded up to one of NumSizeClasses
+ * size classes and served from 64KB blocks carved out of a single address space reservation, with no
+ * per allocation header. Each thread keeps a lock free cache of freed blocks per size class and only
+ * touches the shared bins, in batches, when its cache runs empty or overflows.
+ * Larger or over aligned requests fall back to FMalloc.
+ */
+class FMallocBinned : public FMalloc
+{
+public:
+
+	CONSTEXPR static SIZE_T BlockSize = 64 * 1024;
+	CONSTEXPR static SIZE_T MaxBinnedSize = 32 * 1024;
+	CONSTEXPR static u32 NumSizeClasses = 40;
+	CONSTEXPR static SIZE_T ArenaSize = PLATFORM_64BITS ? (SIZE_T)64 * 1024 * 1024 * 1024 : (SIZE_T)256 * 1024 * 1024;
+
+public:
+
+	CONSTEXPR FMallocBinned() = default;
+
+public:
+
+	virtual void* Malloc(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT) override;
+	virtual void* Realloc(void* ptr, SIZE_T newSize, u64 alignment = DEFAULT_ALIGNMENT) override;
+	virtual void Free(void* ptr) override;
+	virtual bool TryGetAllocationSize(void* ptr, SIZE_T& outSize) override;
+
+private:
+
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	struct FCentralBin
+	{
+		std::mutex Mutex;
+		FFreeBlock* FreeList = nullptr;
+		u8* BumpCursor = nullptr;
+		u8* BumpEnd = nullptr;
+	};
+
+	struct FThreadCache;
+
+private:
+
+	FORCEINLINE bool IsBinned(const void* ptr) const
+	{
+		const UPTRINT base = (UPTRINT)m_ArenaBase.load(std::memory_order_acquire);
+		return (UPTRINT)ptr - base < ArenaSize && base != 0;
+	}
+
+	FORCEINLINE u8 GetBlockSizeClass(const void* ptr) const
+	{
+		const UPTRINT blockIndex = ((UPTRINT)ptr - (UPTRINT)m_ArenaBase.load(std::memory_order_relaxed)) / BlockSize;
+		return m_BlockSizeClasses[blockIndex];
+	}
+
+	bool InitializeArena();
+	u8* AcquireBlock(u32 sizeClass);
+
+	u32 RefillFromCentral(u32 sizeClass, FFreeBlock*& outHead, u32 maxCount);
+	void ReleaseToCentral(u32 sizeClass, FFreeBlock* head, FFreeBlock* tail);
+
+	void FlushThreadCache(FThreadCache& cache);
+
+private:
+
+	std::atomic<u8*> m_ArenaBase = nullptr;
+	std::atomic<SIZE_T> m_NextBlock = 0;
+	u8* m_BlockSizeClasses = nullptr;
+	std::once_flag m_InitializeFlag;
+
+	FCentralBin m_CentralBins[NumSizeClasses];
+
+	static thread_local FThreadCache s_ThreadCache;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Memory/Memory.h"
+#include "Math/Math.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+
+/**
+ * FMalloc decorator that records where memory goes. Every allocation is attributed to the memory tag
+ * active on the allocating thread (see MEMORY_TAG_SCOPE) and to the return address of the Malloc call.
+ *
+ * Counts, byte totals and size histograms are kept in per thread blocks that only their thread writes,
+ * and are summed when a report is gathered. Live bytes are also published per tag to shared counters
+ * every LiveBytesFlushThreshold bytes, which is what the peak values are taken from, so a peak can be
+ * off by at most that threshold per thread.
+ */
+class FMallocTracker : public FMalloc
+{
+public:
+
+	CONSTEXPR static u32 MaxTags = 64;
+	CONSTEXPR static u32 NumSizeBuckets = 32;
+	CONSTEXPR static u32 MaxCallsitesPerThread = 4096;
+	CONSTEXPR static i64 LiveBytesFlushThreshold = 64 * 1024;
+
+	CONSTEXPR static u8 UntaggedTag = 0;
+
+	struct FTagReport
+	{
+		const ANSICHAR* Name;
+		u64 NumAllocations;
+		u64 NumFrees;
+		u64 AllocatedBytes;
+		i64 LiveBytes;
+		i64 PeakLiveBytes;
+
+		// Bucket i counts allocations of [2^i, 2^(i+1)) bytes. Bucket 0 also counts empty ones and the last bucket everything bigger.
+		u64 SizeHistogram[NumSizeBuckets];
+	};
+
+	struct FCallsiteReport
+	{
+		void* Callsite;
+		u64 NumAllocations;
+		u64 AllocatedBytes;
+		i64 LiveBytes;
+	};
+
+public:
+
+	CONSTEXPR explicit FMallocTracker(FMalloc* inner, bool bDumpOnShutdown = false)
+		: m_Inner(inner), m_bDumpOnShutdown(bDumpOnShutdown)
+	{
+	}
+
+	virtual ~FMallocTracker() override;
+
+public:
+
+	virtual void* Malloc(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT) override;
+	virtual void* Realloc(void* ptr, SIZE_T newSize, u64 alignment = DEFAULT_ALIGNMENT) override;
+	virtual void Free(void* ptr) override;
+	virtual bool TryGetAllocationSize(void* ptr, SIZE_T& outSize) override;
+
+public:
+
+	/** Returns the id of the tag with the given name, registering it on first use. Names must outlive the tracker. */
+	static u8 RegisterTag(const ANSICHAR* name);
+
+	static u8 GetCurrentTag();
+	static u8 SetCurrentTag(u8 tag);
+
+	/** Sums all threads into outTags (MaxTags entries, indexed by tag id). Returns the number of registered tags. */
+	u32 GatherTagReports(FTagReport* outTags) const;
+
+	/** Sums all threads and writes up to maxCallsites entries, sorted by allocation count. Returns the number written. */
+	u32 GatherCallsiteReports(FCallsiteReport* outCallsites, u32 maxCallsites) const;
+
+	void DumpReport(FILE* file = stderr, u32 maxCallsites = 32) const;
+
+private:
+
+	struct FThreadStats;
+
+	void* TrackedMalloc(SIZE_T size, u64 alignment, void* callsite);
+
+	FThreadStats& GetThreadStats();
+	void AddLiveBytes(FThreadStats& stats, u8 tag, i64 delta);
+
+private:
+
+	FMalloc* m_Inner;
+	bool m_bDumpOnShutdown;
+
+	std::atomic<i64> m_TagLiveBytes[MaxTags] = {};
+	std::atomic<i64> m_TagPeakLiveBytes[MaxTags] = {};
+
+	mutable std::mutex m_ThreadStatsMutex;
+	FThreadStats* m_ThreadStatsList = nullptr;
+
+	static thread_local FThreadStats* s_ThreadStats;
+};
+
+class FMemoryTagScope
+{
+public:
+
+	FORCEINLINE explicit FMemoryTagScope(u8 tag)
+		: m_PreviousTag(FMallocTracker::SetCurrentTag(tag))
+	{
+	}
+
+	FORCEINLINE ~FMemoryTagScope()
+	{
+		FMallocTracker::SetCurrentTag(m_PreviousTag);
+	}
+
+	FMemoryTagScope(const FMemoryTagScope&) = delete;
+	FMemoryTagScope& operator=(const FMemoryTagScope&) = delete;
+
+private:
+
+	u8 m_PreviousTag;
+};
+
+#define MEMORY_TAG_SCOPE(Name) \
+	static const u8 PREPROCESSOR_JOIN(MemoryTag, __LINE__) = FMallocTracker::RegisterTag(Name); \
+	FMemoryTagScope PREPROCESSOR_JOIN(MemoryTagScope, __LINE__)(PREPROCESSOR_JOIN(MemoryTag, __LINE__))
@@ -1,17 +1,135 @@
 #pragma once
- 
+
 #include "HAL/PlatformMemory.h"
 
+#include <string.h>
+
 #define DEFAULT_ALIGNMENT 0
+#define MIN_ALIGNMENT 16
+
+#if !defined(USE_MALLOC_BINNED)
+	#define USE_MALLOC_BINNED 1
+#endif
 
-static struct FPtrInfo
+#if !defined(USE_MALLOC_TRACKER)
+	#define USE_MALLOC_TRACKER 0
+#endif
+
+struct FPtrInfo
 {
 	SIZE_T DataSize;
 	void* OriginalPointer;
 };
 
 class FMalloc;
-FMalloc* GMalloc;
+extern FMalloc* GMalloc;
+
+class FMalloc
+{
+public:
+
+	virtual ~FMalloc() = default;
+
+public:
+
+	FORCEINLINE virtual void* Malloc(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT)
+	{
+		alignment = alignment < MIN_ALIGNMENT ? MIN_ALIGNMENT : alignment;
+
+		void* ptr = FPlatformMemory::SystemMalloc(size + alignment + sizeof(FPtrInfo));
+		if (ptr == nullptr)
+		{
+			return nullptr;
+		}
+
+		void* alignedPtr = Align((u8*)ptr + sizeof(FPtrInfo), alignment);
+		*((FPtrInfo*)((u8*)alignedPtr - sizeof(FPtrInfo))) = { size, ptr };
+		return alignedPtr;
+	}
+
+	/**
+	 * Resizes an allocation, keeping its content up to the smaller of both sizes. Grows or shrinks in place
+	 * when the block behind ptr is big enough, otherwise moves it. A null ptr allocates and a zero newSize frees.
+	 * On failure returns nullptr and leaves ptr untouched.
+	 */
+	FORCEINLINE virtual void* Realloc(void* ptr, SIZE_T newSize, u64 alignment = DEFAULT_ALIGNMENT)
+	{
+		if (ptr == nullptr)
+		{
+			return Malloc(newSize, alignment);
+		}
+
+		if (newSize == 0)
+		{
+			Free(ptr);
+			return nullptr;
+		}
+
+		alignment = alignment < MIN_ALIGNMENT ? MIN_ALIGNMENT : alignment;
+
+		SIZE_T usableSize;
+		if (!TryGetAllocationSize(ptr, usableSize))
+		{
+			return nullptr;
+		}
+
+		if (newSize <= usableSize && ((UPTRINT)ptr & (alignment - 1)) == 0)
+		{
+			FPtrInfo* header = (FPtrInfo*)((u8*)ptr - sizeof(FPtrInfo));
+			header->DataSize = newSize;
+			return ptr;
+		}
+
+		void* newPtr = Malloc(newSize, alignment);
+		if (newPtr == nullptr)
+		{
+			return nullptr;
+		}
+
+		memcpy(newPtr, ptr, usableSize < newSize ? usableSize : newSize);
+		Free(ptr);
+		return newPtr;
+	}
+
+	FORCEINLINE virtual void Free(void* ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		FPtrInfo* header = (FPtrInfo*)((u8*)ptr - sizeof(FPtrInfo));
+		FPlatformMemory::SystemFree(header->OriginalPointer);
+	}
+
+	/** Returns the usable size of the allocation, which may be bigger than the size it was requested with. */
+	FORCEINLINE virtual bool TryGetAllocationSize(void* ptr, SIZE_T& outSize)
+	{
+		if (ptr == nullptr)
+		{
+			return false;
+		}
+
+		FPtrInfo* header = (FPtrInfo*)((u8*)ptr - sizeof(FPtrInfo));
+
+		SIZE_T systemSize;
+		if (FPlatformMemory::TryGetMemorySize(header->OriginalPointer, systemSize))
+		{
+			outSize = systemSize - ((u8*)ptr - (u8*)header->OriginalPointer);
+			return true;
+		}
+
+		outSize = header->DataSize;
+		return true;
+	}
+
+	template <typename T>
+	FORCEINLINE static constexpr T Align(T value, u64 alignment)
+	{
+		static_assert(TIsIntegral<T>::Value || TIsPointer<T>::Value);
+		return (T)(((u64)value + alignment - 1) & ~(alignment - 1));
+	}
+};
 
 class FAllocatorBaseTraits
 {
@@ -25,76 +143,161 @@ public:
 class FAllocatorBase
 {
 public:
-	class Traits
+
+	typedef FAllocatorBaseTraits Traits;
+};
+
+/** Allocator policy that forwards to GMalloc, the default for containers. */
+class FHeapAllocator : public FAllocatorBase
+{
+public:
+
+	FORCEINLINE void* Allocate(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT)
+	{
+		return GMalloc->Malloc(size, alignment);
+	}
+
+	FORCEINLINE void* Reallocate(void* ptr, SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT)
 	{
+		return GMalloc->Realloc(ptr, size, alignment);
+	}
 
-	};
+	FORCEINLINE void Free(void* ptr)
+	{
+		GMalloc->Free(ptr);
+	}
+
+	FORCEINLINE SIZE_T GetAllocationSize(void* ptr, SIZE_T requestedSize)
+	{
+		SIZE_T size;
+		return GMalloc->TryGetAllocationSize(ptr, size) ? size : requestedSize;
+	}
 };
 
+/**
+ * Linear arena. Allocation bumps a cursor, memory is given back either all at once with Reset or
+ * down to a marker taken earlier with GetMarker. Nothing can be freed individually.
+ * When double buffered, SwapBuffers starts a new frame in the other half of the arena while
+ * the allocations of the previous frame stay readable until the following swap.
+ */
 class FStackAllocator : public FAllocatorBase
 {
 public:
+
 	class Traits : public FAllocatorBase::Traits
 	{
+	public:
+
 		CONSTEXPR static bool IsReallocationAllowed = false;
 		CONSTEXPR static bool CanRandomFree = false;
 	};
 
+	typedef UPTRINT FMarker;
+
 public:
 
-	CONSTEXPR FStackAllocator(SIZE_T)
+	FORCEINLINE FStackAllocator(SIZE_T capacity, bool bDoubleBuffered = false)
+		: m_Capacity(capacity), m_bDoubleBuffered(bDoubleBuffered)
 	{
-		m_Base = GMalloc->Malloc()
+		const SIZE_T numBuffers = bDoubleBuffered ? 2 : 1;
+
+		m_Memory = (u8*)GMalloc->Malloc(capacity * numBuffers, MIN_ALIGNMENT);
+		m_Base = (UPTRINT)m_Memory;
+		m_Top = m_Base;
+		m_End = m_Base + capacity;
 	}
 
-private: 
+	FStackAllocator(const FStackAllocator&) = delete;
+	FStackAllocator& operator=(const FStackAllocator&) = delete;
 
-	UPTRINT m_Base;
-};
+	FORCEINLINE ~FStackAllocator()
+	{
+		GMalloc->Free(m_Memory);
+	}
 
-class FMalloc 
-{
 public:
 
-	FORCEINLINE virtual void* Malloc(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT)
+	FORCEINLINE void* Allocate(SIZE_T size, u64 alignment = DEFAULT_ALIGNMENT)
 	{
-		void* ptr = FPlatformMemory::SystemMalloc(size);
-		if (ptr == nullptr)
+		const UPTRINT ptr = FMalloc::Align(m_Top, alignment < MIN_ALIGNMENT ? MIN_ALIGNMENT : alignment);
+		if (ptr + size > m_End)
 		{
-			void* alignedPtr = Align((u8*)ptr + sizeof(FPtrInfo), alignment);
-			*((FPtrInfo*)((u8*)alignedPtr - sizeof(FPtrInfo))) = { size, ptr };
+			return nullptr;
 		}
 
-		return nullptr;
+		m_Top = ptr + size;
+		return (void*)ptr;
 	}
 
-	FORCEINLINE virtual void Free(void* ptr)
+	template<typename T>
+	FORCEINLINE T* AllocateArray(SIZE_T count)
 	{
-		if (ptr == nullptr)
-		{
-			return;
-		}
+		return (T*)Allocate(sizeof(T) * count, alignof(T));
+	}
 
-		FPtrInfo* header = (FPtrInfo*)((u8*)ptr - sizeof(FPtrInfo));
-		FPlatformMemory::SystemFree(header->OriginalPointer);
+	FORCEINLINE FMarker GetMarker() const
+	{
+		return m_Top;
 	}
 
-	FORCEINLINE virtual bool TryGetAllocationSize(void* ptr, SIZE_T& outSize)
+	FORCEINLINE void FreeToMarker(FMarker marker)
 	{
-		if (ptr == nullptr)
+		CHECK(marker >= m_Base && marker <= m_Top);
+		m_Top = marker;
+	}
+
+	FORCEINLINE void Reset()
+	{
+		m_Top = m_Base;
+	}
+
+	FORCEINLINE void SwapBuffers()
+	{
+		if (m_bDoubleBuffered)
 		{
-			return false;
+			m_Base = m_Base == (UPTRINT)m_Memory ? (UPTRINT)m_Memory + m_Capacity : (UPTRINT)m_Memory;
+			m_End = m_Base + m_Capacity;
 		}
 
-		FPtrInfo* header = (FPtrInfo*)((u8*)ptr - sizeof(FPtrInfo));
-		outSize = header->DataSize;
-		return true;
+		Reset();
 	}
 
-	template <typename T>
-	FORCEINLINE static constexpr T Align(T value, u64 alignment)
+public:
+
+	FORCEINLINE SIZE_T GetCapacity() const { return m_Capacity; }
+	FORCEINLINE SIZE_T GetUsedSize() const { return m_Top - m_Base; }
+	FORCEINLINE bool IsDoubleBuffered() const { return m_bDoubleBuffered; }
+
+private:
+
+	u8* m_Memory;
+	SIZE_T m_Capacity;
+	bool m_bDoubleBuffered;
+
+	UPTRINT m_Base;
+	UPTRINT m_Top;
+	UPTRINT m_End;
+};
+
+class FStackAllocatorMarkScope
+{
+public:
+
+	FORCEINLINE explicit FStackAllocatorMarkScope(FStackAllocator& allocator)
+		: m_Allocator(allocator), m_Marker(allocator.GetMarker())
 	{
-		static_assert(TIsIntegral<T>::Value || TIsPointer<T>::Value);
-		return (T)(((u64)value + alignment - 1) & ~(alignment - 1));
 	}
+
+	FORCEINLINE ~FStackAllocatorMarkScope()
+	{
+		m_Allocator.FreeToMarker(m_Marker);
+	}
+
+	FStackAllocatorMarkScope(const FStackAllocatorMarkScope&) = delete;
+	FStackAllocatorMarkScope& operator=(const FStackAllocatorMarkScope&) = delete;
+
+private:
+
+	FStackAllocator& m_Allocator;
+	FStackAllocator::FMarker m_Marker;
 };
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "HAL/Platform.h"
+#include "TypeTraits.h"
+
+#include <atomic>
+#include <new>
+#include <string.h>
+
+#if !defined(MEMORY_STREAMING_THRESHOLD)
+	#define MEMORY_STREAMING_THRESHOLD (2 * 1024 * 1024)
+#endif
+
+/**
+ * Copy and fill entry points. Blocks up to SmallSize bytes are handled inline with a few overlapping loads
+ * and stores; bigger ones go to a kernel chosen from the CPU features on first use (AVX2, SSE2 or the C
+ * library). From the streaming threshold on the kernels write with non-temporal stores, so a large copy
+ * doesn't evict the working set from the cache.
+ */
+struct FMemory
+{
+public:
+
+	typedef void* (*FMemcpyFunction)(void* dest, const void* src, SIZE_T size);
+	typedef void* (*FMemsetFunction)(void* dest, u8 value, SIZE_T size);
+
+	CONSTEXPR static SIZE_T SmallSize = 64;
+
+public:
+
+	/** Copies size bytes. The ranges must not overlap, use Memmove for that. */
+	FORCEINLINE static void* Memcpy(void* dest, const void* src, SIZE_T size)
+	{
+		if (size <= SmallSize)
+		{
+			SmallMemcpy((u8*)dest, (const u8*)src, size);
+			return dest;
+		}
+
+		return s_MemcpyKernel.load(std::memory_order_relaxed)(dest, src, size);
+	}
+
+	FORCEINLINE static void* Memmove(void* dest, const void* src, SIZE_T size)
+	{
+		return memmove(dest, src, size);
+	}
+
+	FORCEINLINE static void* Memset(void* dest, u8 value, SIZE_T size)
+	{
+		if (size <= SmallSize)
+		{
+			SmallMemset((u8*)dest, value, size);
+			return dest;
+		}
+
+		return s_MemsetKernel.load(std::memory_order_relaxed)(dest, value, size);
+	}
+
+	FORCEINLINE static void* Memzero(void* dest, SIZE_T size)
+	{
+		return Memset(dest, 0, size);
+	}
+
+	template<typename T>
+	FORCEINLINE static void Memzero(T& object)
+	{
+		static_assert(!TIsPointer<T>::Value, "Memzero would clear the pointer, not what it points to.");
+		Memset(&object, 0, sizeof(T));
+	}
+
+	FORCEINLINE static i32 Memcmp(const void* lhs, const void* rhs, SIZE_T size)
+	{
+		return memcmp(lhs, rhs, size);
+	}
+
+public:
+
+	/** Size from which copies and fills bypass the cache. Meant to be tuned once at startup. */
+	static void SetStreamingThreshold(SIZE_T size);
+	static SIZE_T GetStreamingThreshold();
+
+	/** Replaces the kernels used for blocks bigger than SmallSize. They are selected from the CPU features by default. */
+	static void SetKernels(FMemcpyFunction memcpyKernel, FMemsetFunction memsetKernel);
+
+public:
+
+	/** Default constructs count items at dest, zero filling them when that is equivalent. */
+	template<typename T>
+	FORCEINLINE static void DefaultConstructItems(void* dest, i32 count)
+	{
+		if constexpr (TIsZeroConstructType<T>::Value)
+		{
+			Memzero(dest, (SIZE_T)count * sizeof(T));
+		}
+		else
+		{
+			for (i32 i = 0; i < count; ++i)
+			{
+				new ((T*)dest + i) T();
+			}
+		}
+	}
+
+	/** Copy constructs count items at dest from source. The ranges must not overlap. */
+	template<typename T>
+	FORCEINLINE static void ConstructItems(void* dest, const T* source, i32 count)
+	{
+		if constexpr (TOr<TIsPODType<T>, TIsTriviallyCopyable<T>>::Value)
+		{
+			Memcpy(dest, source, (SIZE_T)count * sizeof(T));
+		}
+		else
+		{
+			for (i32 i = 0; i < count; ++i)
+			{
+				new ((T*)dest + i) T(source[i]);
+			}
+		}
+	}
+
+	template<typename T>
+	FORCEINLINE static void DestructItems(T* items, i32 count)
+	{
+		if constexpr (!TOr<TIsPODType<T>, TIsTriviallyDestructible<T>>::Value)
+		{
+			for (i32 i = 0; i < count; ++i)
+			{
+				items[i].~T();
+			}
+		}
+	}
+
+	/**
+	 * Moves count items from source to dest, leaving source as raw memory. The ranges may overlap when dest
+	 * comes before source, which is what removing from the middle of an array needs.
+	 */
+	template<typename T>
+	FORCEINLINE static void RelocateItems(void* dest, T* source, i32 count)
+	{
+		if constexpr (TIsTriviallyRelocatable<T>::Value)
+		{
+			Memmove(dest, source, (SIZE_T)count * sizeof(T));
+		}
+		else
+		{
+			for (i32 i = 0; i < count; ++i)
+			{
+				new ((T*)dest + i) T(MoveTemp(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	template<typename T>
+	FORCEINLINE static bool CompareItems(const T* lhs, const T* rhs, i32 count)
+	{
+		if constexpr (TIsBitwiseComparable<T>::Value)
+		{
+			return Memcmp(lhs, rhs, (SIZE_T)count * sizeof(T)) == 0;
+		}
+		else
+		{
+			for (i32 i = 0; i < count; ++i)
+			{
+				if (!(lhs[i] == rhs[i]))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+private:
+
+	// Every size is covered by two accesses of the largest width that fits, the second one ending at the
+	// last byte, so there is no loop. All loads happen before the stores.
+	template<SIZE_T Width>
+	FORCEINLINE static void CopyHeadAndTail(u8* dest, const u8* src, SIZE_T size)
+	{
+		u8 head[Width];
+		u8 tail[Width];
+		memcpy(head, src, Width);
+		memcpy(tail, src + size - Width, Width);
+		memcpy(dest, head, Width);
+		memcpy(dest + size - Width, tail, Width);
+	}
+
+	template<SIZE_T Width>
+	FORCEINLINE static void FillHeadAndTail(u8* dest, u64 pattern, SIZE_T size)
+	{
+		u64 block[Width / 8 > 0 ? Width / 8 : 1] = { };
+		for (SIZE_T i = 0; i < sizeof(block) / 8; ++i)
+		{
+			block[i] = pattern;
+		}
+
+		memcpy(dest, block, Width);
+		memcpy(dest + size - Width, block, Width);
+	}
+
+	FORCEINLINE static void SmallMemcpy(u8* dest, const u8* src, SIZE_T size)
+	{
+		if (size > 32)
+		{
+			CopyHeadAndTail<32>(dest, src, size);
+		}
+		else if (size >= 16)
+		{
+			CopyHeadAndTail<16>(dest, src, size);
+		}
+		else if (size >= 8)
+		{
+			CopyHeadAndTail<8>(dest, src, size);
+		}
+		else if (size >= 4)
+		{
+			CopyHeadAndTail<4>(dest, src, size);
+		}
+		else if (size > 0)
+		{
+			const u8 first = src[0];
+			const u8 middle = src[size / 2];
+			const u8 last = src[size - 1];
+			dest[0] = first;
+			dest[size / 2] = middle;
+			dest[size - 1] = last;
+		}
+	}
+
+	FORCEINLINE static void SmallMemset(u8* dest, u8 value, SIZE_T size)
+	{
+		const u64 pattern = 0x0101010101010101ull * value;
+
+		if (size > 32)
+		{
+			FillHeadAndTail<32>(dest, pattern, size);
+		}
+		else if (size >= 16)
+		{
+			FillHeadAndTail<16>(dest, pattern, size);
+		}
+		else if (size >= 8)
+		{
+			FillHeadAndTail<8>(dest, pattern, size);
+		}
+		else if (size >= 4)
+		{
+			FillHeadAndTail<4>(dest, pattern, size);
+		}
+		else if (size > 0)
+		{
+			dest[0] = value;
+			dest[size / 2] = value;
+			dest[size - 1] = value;
+		}
+	}
+
+private:
+
+	static std::atomic<FMemcpyFunction> s_MemcpyKernel;
+	static std::atomic<FMemsetFunction> s_MemsetKernel;
+};
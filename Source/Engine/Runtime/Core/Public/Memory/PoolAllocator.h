@@ -0,0 +1,229 @@
+#pragma once
+
+#include "Memory/Memory.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+/**
+ * Fixed size allocator for elements of type T. Elements live in one address space reservation that is
+ * committed in ChunkSize steps as the pool grows, and freed elements are kept in an intrusive free list
+ * of 32 bit element indices.
+ * When Concurrent is true the free list head packs the index with a 32 bit version tag that changes on
+ * every push and pop, which makes the compare-and-swap loops immune to ABA.
+ */
+template<typename T, bool Concurrent = false>
+class TPoolAllocator : public FAllocatorBase
+{
+public:
+
+	class Traits : public FAllocatorBase::Traits
+	{
+	public:
+
+		CONSTEXPR static bool IsReallocationAllowed = false;
+		CONSTEXPR static bool IsConcurrent = Concurrent;
+	};
+
+	// Free elements hold a u32 link, so the stride keeps it aligned even when T is not.
+	CONSTEXPR static SIZE_T ElementAlignment = alignof(T) < alignof(u32) ? alignof(u32) : alignof(T);
+	CONSTEXPR static SIZE_T ElementSize = FMalloc::Align(sizeof(T) < sizeof(u32) ? sizeof(u32) : sizeof(T), ElementAlignment);
+	CONSTEXPR static SIZE_T ChunkSize = 64 * 1024;
+	CONSTEXPR static u32 DefaultMaxElements = 1024 * 1024;
+
+	static_assert(alignof(T) <= 4096, "TPoolAllocator doesn't support alignments bigger than a page.");
+
+public:
+
+	FORCEINLINE explicit TPoolAllocator(u32 maxElements = DefaultMaxElements)
+		: m_MaxElements(maxElements), m_FreeHead(PackHead(InvalidIndex, 0)), m_NextUnused(0), m_CommittedSize(0)
+	{
+		m_ReservedSize = (SIZE_T)maxElements * ElementSize;
+		m_Base = (u8*)FPlatformMemory::ReserveAddressSpace(m_ReservedSize);
+		if (m_Base == nullptr)
+		{
+			m_MaxElements = 0;
+		}
+	}
+
+	TPoolAllocator(const TPoolAllocator&) = delete;
+	TPoolAllocator& operator=(const TPoolAllocator&) = delete;
+
+	FORCEINLINE ~TPoolAllocator()
+	{
+		FPlatformMemory::ReleaseAddressSpace(m_Base, m_ReservedSize);
+	}
+
+public:
+
+	/** Returns uninitialized storage for one T, or nullptr once MaxElements are in use. */
+	FORCEINLINE T* Allocate()
+	{
+		u64 head = m_FreeHead.load(std::memory_order_acquire);
+
+		while (GetHeadIndex(head) != InvalidIndex)
+		{
+			const u32 index = GetHeadIndex(head);
+			const u32 next = GetNextIndex(index).load(std::memory_order_relaxed);
+
+			if constexpr (Concurrent)
+			{
+				if (m_FreeHead.compare_exchange_weak(head, PackHead(next, GetHeadTag(head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+				{
+					return (T*)GetElement(index);
+				}
+			}
+			else
+			{
+				m_FreeHead.store(PackHead(next, GetHeadTag(head)), std::memory_order_relaxed);
+				return (T*)GetElement(index);
+			}
+		}
+
+		u32 index;
+		if constexpr (Concurrent)
+		{
+			index = m_NextUnused.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			index = m_NextUnused.load(std::memory_order_relaxed);
+			m_NextUnused.store(index + 1, std::memory_order_relaxed);
+		}
+
+		if (index >= m_MaxElements || !EnsureCommitted(index))
+		{
+			return nullptr;
+		}
+
+		return (T*)GetElement(index);
+	}
+
+	FORCEINLINE void Free(T* ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		CHECK(Owns(ptr));
+
+		const u32 index = (u32)(((u8*)ptr - m_Base) / ElementSize);
+		u64 head = m_FreeHead.load(std::memory_order_relaxed);
+
+		if constexpr (Concurrent)
+		{
+			do
+			{
+				GetNextIndex(index).store(GetHeadIndex(head), std::memory_order_relaxed);
+			}
+			while (!m_FreeHead.compare_exchange_weak(head, PackHead(index, GetHeadTag(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+		}
+		else
+		{
+			GetNextIndex(index).store(GetHeadIndex(head), std::memory_order_relaxed);
+			m_FreeHead.store(PackHead(index, GetHeadTag(head)), std::memory_order_relaxed);
+		}
+	}
+
+	template<typename... ArgTypes>
+	FORCEINLINE T* New(ArgTypes&&... args)
+	{
+		T* ptr = Allocate();
+		return ptr != nullptr ? new (ptr) T(static_cast<ArgTypes&&>(args)...) : nullptr;
+	}
+
+	FORCEINLINE void Delete(T* ptr)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		ptr->~T();
+		Free(ptr);
+	}
+
+public:
+
+	FORCEINLINE bool Owns(const void* ptr) const
+	{
+		return (const u8*)ptr >= m_Base && (const u8*)ptr < m_Base + m_ReservedSize;
+	}
+
+	FORCEINLINE u32 GetMaxElements() const { return m_MaxElements; }
+	FORCEINLINE SIZE_T GetCommittedSize() const { return m_CommittedSize.load(std::memory_order_relaxed); }
+
+private:
+
+	CONSTEXPR static u32 InvalidIndex = 0xFFFFFFFF;
+
+	FORCEINLINE static u64 PackHead(u32 index, u32 tag) { return ((u64)tag << 32) | index; }
+	FORCEINLINE static u32 GetHeadIndex(u64 head) { return (u32)head; }
+	FORCEINLINE static u32 GetHeadTag(u64 head) { return (u32)(head >> 32); }
+
+	FORCEINLINE u8* GetElement(u32 index) const
+	{
+		return m_Base + (SIZE_T)index * ElementSize;
+	}
+
+	// A free element stores the index of the next free element in its first four bytes. Concurrent pops can
+	// read it while another thread reuses the element, so it is accessed atomically; the stale value that
+	// read may produce is discarded by the tagged compare-and-swap.
+	FORCEINLINE std::atomic<u32>& GetNextIndex(u32 index) const
+	{
+		return *(std::atomic<u32>*)GetElement(index);
+	}
+
+	bool EnsureCommitted(u32 index)
+	{
+		const SIZE_T requiredSize = ((SIZE_T)index + 1) * ElementSize;
+		if (requiredSize <= m_CommittedSize.load(std::memory_order_acquire))
+		{
+			return true;
+		}
+
+		if constexpr (Concurrent)
+		{
+			std::lock_guard<std::mutex> lock(m_CommitMutex);
+			return CommitUpTo(requiredSize);
+		}
+		else
+		{
+			return CommitUpTo(requiredSize);
+		}
+	}
+
+	bool CommitUpTo(SIZE_T requiredSize)
+	{
+		const SIZE_T committedSize = m_CommittedSize.load(std::memory_order_relaxed);
+		if (requiredSize <= committedSize)
+		{
+			return true;
+		}
+
+		SIZE_T newCommittedSize = FMalloc::Align(requiredSize, ChunkSize);
+		newCommittedSize = newCommittedSize < m_ReservedSize ? newCommittedSize : m_ReservedSize;
+
+		// The committed size is always chunk aligned until it reaches the end of the reservation.
+		if (!FPlatformMemory::CommitPages(m_Base + committedSize, newCommittedSize - committedSize))
+		{
+			return false;
+		}
+
+		m_CommittedSize.store(newCommittedSize, std::memory_order_release);
+		return true;
+	}
+
+private:
+
+	u8* m_Base;
+	SIZE_T m_ReservedSize;
+	u32 m_MaxElements;
+
+	std::atomic<u64> m_FreeHead;
+	std::atomic<u32> m_NextUnused;
+	std::atomic<SIZE_T> m_CommittedSize;
+	std::mutex m_CommitMutex;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+#include <string.h>
+
+/*--------------------------------------------------------------------------*/
+
+namespace Private
+{
+	/** Finalizer of splitmix64, spreads every input bit over the whole hash. */
+	FORCEINLINE CONSTEXPR u64 MixHash(u64 value)
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+}
+
+/*--------------------------------------------------------------------------*/
+
+FORCEINLINE CONSTEXPR u64 GetTypeHash(bool value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(ANSICHAR value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(WIDECHAR value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(i8 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(u8 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(i16 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(u16 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(i32 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(u32 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(long value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(unsigned long value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(i64 value) { return Private::MixHash((u64)value); }
+FORCEINLINE CONSTEXPR u64 GetTypeHash(u64 value) { return Private::MixHash(value); }
+
+FORCEINLINE u64 GetTypeHash(float value)
+{
+	// +0 and -0 compare equal so they must hash equal.
+	u32 bits;
+	value = value == 0.0f ? 0.0f : value;
+	memcpy(&bits, &value, sizeof(bits));
+	return Private::MixHash(bits);
+}
+
+FORCEINLINE u64 GetTypeHash(double value)
+{
+	u64 bits;
+	value = value == 0.0 ? 0.0 : value;
+	memcpy(&bits, &value, sizeof(bits));
+	return Private::MixHash(bits);
+}
+
+template<typename T>
+FORCEINLINE u64 GetTypeHash(T* ptr)
+{
+	return Private::MixHash((u64)(UPTRINT)ptr);
+}
+
+/** Hashes a range of bytes, 64 bit FNV-1a followed by the mix. */
+FORCEINLINE u64 GetBytesHash(const void* data, SIZE_T size)
+{
+	u64 hash = 0xCBF29CE484222325ull;
+	for (SIZE_T i = 0; i < size; ++i)
+	{
+		hash = (hash ^ ((const u8*)data)[i]) * 0x100000001B3ull;
+	}
+
+	return Private::MixHash(hash);
+}
+
+/**
+ * Hashes the characters of a null terminated string, the same as FString and FStringView do. Without it,
+ * looking up string keys by a literal would pick the pointer overload and hash the address.
+ */
+FORCEINLINE u64 GetTypeHash(const TCHAR* str)
+{
+	SIZE_T length = 0;
+	while (str != nullptr && str[length] != 0)
+	{
+		++length;
+	}
+
+	return GetBytesHash(str, length * sizeof(TCHAR));
+}
+
+FORCEINLINE u64 GetTypeHash(TCHAR* str)
+{
+	return GetTypeHash((const TCHAR*)str);
+}
+
+FORCEINLINE CONSTEXPR u64 HashCombine(u64 lhs, u64 rhs)
+{
+	return Private::MixHash(lhs ^ (rhs + 0x9E3779B97F4A7C15ull + (lhs << 6) + (lhs >> 2)));
+}
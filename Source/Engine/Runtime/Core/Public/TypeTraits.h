@@ -2,6 +2,8 @@
 
 #include "HAL/Platform.h"
 
+#include <type_traits>
+
 /*--------------------------------------------------------------------------*/
 
 namespace Private
@@ -79,13 +81,19 @@ namespace Private
 	template<typename T> struct TIsIntegralHelper : TFalseType { };
 	template<> struct TIsIntegralHelper<bool> : FTrueType { };
 	template<> struct TIsIntegralHelper<char> : FTrueType { };
+	template<> struct TIsIntegralHelper<signed char> : FTrueType { };
+	template<> struct TIsIntegralHelper<unsigned char> : FTrueType { };
 	template<> struct TIsIntegralHelper<char16_t> : FTrueType { };
 	template<> struct TIsIntegralHelper<char32_t> : FTrueType { };
 	template<> struct TIsIntegralHelper<wchar_t> : FTrueType { };
 	template<> struct TIsIntegralHelper<short> : FTrueType { };
+	template<> struct TIsIntegralHelper<unsigned short> : FTrueType { };
 	template<> struct TIsIntegralHelper<int> : FTrueType { };
+	template<> struct TIsIntegralHelper<unsigned int> : FTrueType { };
 	template<> struct TIsIntegralHelper<long> : FTrueType { };
+	template<> struct TIsIntegralHelper<unsigned long> : FTrueType { };
 	template<> struct TIsIntegralHelper<long long> : FTrueType { };
+	template<> struct TIsIntegralHelper<unsigned long long> : FTrueType { };
 }
 
 template<typename T> struct TIsIntegral : Private::TIsIntegralHelper<typename TRemoveCV<T>::Type> { };
@@ -118,6 +126,65 @@ template <typename T> struct TIsPointer : Private::TIsPointerHelper<typename TRe
 
 /*--------------------------------------------------------------------------*/
 
+template<typename T> struct TRemoveReference : Private::TType<T> { };
+template<typename T> struct TRemoveReference<T&> : Private::TType<T> { };
+template<typename T> struct TRemoveReference<T&&> : Private::TType<T> { };
+
+/*--------------------------------------------------------------------------*/
+
+template<typename T> struct TIsTriviallyCopyable : TConstBoolean<__is_trivially_copyable(T)> { };
+template<typename T> struct TIsTriviallyDestructible : TConstBoolean<std::is_trivially_destructible_v<T>> { };
+
+/*--------------------------------------------------------------------------*/
+
+template<typename T> struct TIsEnum : TConstBoolean<__is_enum(T)> { };
+
+/*--------------------------------------------------------------------------*/
+
+/**
+ * The traits below are specialized to true for types the compiler can't prove them for, usually because of a
+ * user provided copy constructor that only copies the members.
+ */
+
+/** Objects can be moved to another address with memcpy, leaving nothing to destroy at the old one. */
+template<typename T> struct TIsTriviallyRelocatable : TIsTriviallyCopyable<T> { };
+
+/** Default construction is the same as filling the object with zeros. */
+template<typename T> struct TIsZeroConstructType : TOr<TIsArithmetic<T>, TIsPointer<T>, TIsEnum<T>> { };
+
+/** Objects can be copied with memcpy and need no destruction. */
+template<typename T> struct TIsPODType : TConstBoolean<__is_trivial(T) && __is_standard_layout(T)> { };
+
+/**
+ * Equality is the same as comparing the bytes with memcmp. Plain floating point types are excluded, as -0 equals
+ * +0 and NaN never equals itself. The float math types (FVector, FVector4, FQuat, FMatrix, FTransform, FPlane,
+ * FSphere, FBox, FFrustum) opt in anyway since they have no operator==: arrays of them compare exactly, with -0
+ * different from +0 and a NaN equal to itself.
+ */
+template<typename T> struct TIsBitwiseComparable : TOr<TIsIntegral<T>, TIsPointer<T>, TIsEnum<T>> { };
+
+/*--------------------------------------------------------------------------*/
+
+template<typename T>
+FORCEINLINE CONSTEXPR typename TRemoveReference<T>::Type&& MoveTemp(T&& value)
+{
+	return static_cast<typename TRemoveReference<T>::Type&&>(value);
+}
+
+template<typename T>
+FORCEINLINE CONSTEXPR T&& Forward(typename TRemoveReference<T>::Type& value)
+{
+	return static_cast<T&&>(value);
+}
+
+template<typename T>
+FORCEINLINE CONSTEXPR T&& Forward(typename TRemoveReference<T>::Type&& value)
+{
+	return static_cast<T&&>(value);
+}
+
+/*--------------------------------------------------------------------------*/
+
 #define DECLARE_HAS_INSTANCE_FUNCTION(TraitName, FunctionName, Signature) \
 WARNING(push) \
 WARNING(disable:4067) \
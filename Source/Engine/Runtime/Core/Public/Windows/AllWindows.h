@@ -1,4 +1,5 @@
 #pragma once
 
 #include "Windows/WindowsPlatform.h"
-#include "Windows/WindowsPlatformMemory.h"
\ No newline at end of file
+#include "Windows/WindowsPlatformMemory.h"
+#include "Windows/WindowsPlatformMisc.h"
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <windows.h>
 #include <winbase.h>
+#include <intrin.h>
 
 struct FWindowsPlatformTypes;
 typedef FWindowsPlatformTypes FPlatformTypes;
@@ -37,6 +38,7 @@ struct FWindowsPlatformTypes : public FGenericPlatformTypes
 #define ABSTRACT abstract
 #define DLLIMPORT __declspec(dllimport)
 #define DLLEXPORT __declspec(dllexpsort)
+#define PLATFORM_RETURN_ADDRESS() _ReturnAddress()
 
 
 #define PLATFORM_64BITS (_WIN64)
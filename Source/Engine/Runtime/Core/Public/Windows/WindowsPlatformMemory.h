@@ -3,6 +3,8 @@
 #include "GenericPlatform/GenericPlatformMemory.h"
 
 #include <heapapi.h>
+#include <memoryapi.h>
+#include <sysinfoapi.h>
 
 struct FWindowsPlatformMemory;
 typedef FWindowsPlatformMemory FPlatformMemory;
@@ -40,4 +42,97 @@ struct FWindowsPlatformMemory : public FGenericPlatformMemory
 		outSize = size;
 		return true;
 	}
+
+public:
+
+	FORCEINLINE static SIZE_T GetPageSize()
+	{
+		static const SIZE_T pageSize = QuerySystemInfo().dwPageSize;
+		return pageSize;
+	}
+
+	FORCEINLINE static SIZE_T GetHugePageSize()
+	{
+		static const SIZE_T largePageMinimum = GetLargePageMinimum();
+		return largePageMinimum != 0 ? largePageMinimum : FGenericPlatformMemory::GetHugePageSize();
+	}
+
+	FORCEINLINE static u64 GetTotalPhysicalMemory()
+	{
+		MEMORYSTATUSEX memoryStatus = {};
+		memoryStatus.dwLength = sizeof(memoryStatus);
+		GlobalMemoryStatusEx(&memoryStatus);
+		return memoryStatus.ullTotalPhys;
+	}
+
+public:
+
+	FORCEINLINE static void* ReserveAddressSpace(SIZE_T size, EPlatformPageBacking backing = EPlatformPageBacking::Default)
+	{
+		// Windows has no transparent huge pages and large pages can't be reserved without being committed.
+		return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+	}
+
+	FORCEINLINE static bool CommitPages(void* ptr, SIZE_T size)
+	{
+		return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+	}
+
+	FORCEINLINE static bool DecommitPages(void* ptr, SIZE_T size)
+	{
+		return VirtualFree(ptr, size, MEM_DECOMMIT) != 0;
+	}
+
+	FORCEINLINE static void ReleaseAddressSpace(void* ptr, SIZE_T size)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		BOOL bSuccess = VirtualFree(ptr, 0, MEM_RELEASE);
+		CHECK(bSuccess);
+	}
+
+	FORCEINLINE static void* AllocatePages(SIZE_T size, EPlatformPageBacking backing = EPlatformPageBacking::Default, EPlatformPageBacking* outBacking = nullptr)
+	{
+		if (backing == EPlatformPageBacking::ExplicitHuge)
+		{
+			// Requires SeLockMemoryPrivilege; fall back to regular pages when it isn't held.
+			const SIZE_T largePageSize = GetHugePageSize();
+			const SIZE_T largeSize = (size + largePageSize - 1) & ~(largePageSize - 1);
+			void* ptr = VirtualAlloc(nullptr, largeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (ptr != nullptr)
+			{
+				if (outBacking != nullptr)
+				{
+					*outBacking = EPlatformPageBacking::ExplicitHuge;
+				}
+
+				return ptr;
+			}
+		}
+
+		if (outBacking != nullptr)
+		{
+			*outBacking = EPlatformPageBacking::Default;
+		}
+
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	FORCEINLINE static void FreePages(void* ptr, SIZE_T size, EPlatformPageBacking = EPlatformPageBacking::Default)
+	{
+		// MEM_RELEASE frees the whole allocation whatever its page size.
+		ReleaseAddressSpace(ptr, size);
+	}
+
+private:
+
+	FORCEINLINE static SYSTEM_INFO QuerySystemInfo()
+	{
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		return systemInfo;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "GenericPlatform/GenericPlatformMisc.h"
+
+struct FWindowsPlatformMisc;
+typedef FWindowsPlatformMisc FPlatformMisc;
+
+struct FWindowsPlatformMisc : public FGenericPlatformMisc
+{
+	FORCEINLINE static u32 GetCPUFeatures()
+	{
+		static const u32 features = QueryCPUFeatures();
+		return features;
+	}
+
+	FORCEINLINE static bool HasCPUFeature(ECPUFeature feature)
+	{
+		return (GetCPUFeatures() & (u32)feature) != 0;
+	}
+
+private:
+
+	static u32 QueryCPUFeatures()
+	{
+		u32 features = 0;
+
+#if PLATFORM_CPU_X86_FAMILY
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		const bool bOSXSave = (info[2] & (1 << 27)) != 0;
+
+		// AVX state has to be enabled by the operating system, not just supported by the processor.
+		const bool bOSSavesAVX = bOSXSave && (_xgetbv(0) & 0x6) == 0x6;
+
+		features |= (info[3] & (1 << 26)) ? (u32)ECPUFeature::SSE2 : 0;
+		features |= (info[2] & (1 << 19)) ? (u32)ECPUFeature::SSE41 : 0;
+		features |= bOSSavesAVX && (info[2] & (1 << 28)) ? (u32)ECPUFeature::AVX : 0;
+		features |= bOSSavesAVX && (info[2] & (1 << 12)) ? (u32)ECPUFeature::FMA3 : 0;
+		features |= bOSSavesAVX && (info[2] & (1 << 29)) ? (u32)ECPUFeature::F16C : 0;
+
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			features |= bOSSavesAVX && (info[1] & (1 << 5)) ? (u32)ECPUFeature::AVX2 : 0;
+		}
+#elif PLATFORM_CPU_ARM_FAMILY
+		features |= (u32)ECPUFeature::NEON;
+#endif
+
+		return features;
+	}
+};